@@ -0,0 +1,91 @@
+//Measures a sweep over seeds of a small stochastic plant, generated one after another, with a thread per system, and as a batch
+//Usage: batch_bench [systems] [generations] [threads]
+
+#include <chrono>
+#include <iostream>
+#include <cassert>
+#include <stdlib.h>
+#include <thread>
+
+#include "l_system/l_batch.h"
+
+using namespace l_system;
+
+template <typename F>
+auto seconds(F&& f) -> double {
+
+  const auto start = std::chrono::steady_clock::now();
+
+  f();
+
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  return elapsed.count();
+}
+
+int main(int argc, char const *argv[]) {
+
+  size_t count = (argc >= 2) ? strtoull(argv[1], nullptr, 0) : 4096;
+  int generations = (argc >= 3) ? static_cast<int>(strtol(argv[2], nullptr, 0)) : 6;
+  unsigned threads = (argc >= 4) ? static_cast<unsigned>(strtoul(argv[3], nullptr, 0)) : std::max(1u, std::thread::hardware_concurrency());
+  assert(generations >= 0 && "Usage: batch_bench [systems] [generations] [threads]");
+
+  LSymbolType f('F');
+  LSymbolType left('+');
+  LSymbolType right('-');
+  LSymbolType push('[');
+  LSymbolType pop(']');
+
+  std::vector<LSystem<char>> systems;
+  systems.reserve(count);
+
+  for(size_t seed = 0; seed < count; ++seed) {
+
+    LSystem<char> plant({LSymbol(f)});
+    plant.addRule(LRule<char>(f, LAlternatives<char>{
+      {1.0, {f, push, left, f, pop, f, push, right, f, pop, f}},
+      {1.0, {f, push, left, f, pop, f}},
+      {2.0, {f, push, right, f, pop, f}}
+    }));
+    plant.setSeed(seed);
+
+    systems.emplace_back(std::move(plant));
+  }
+
+  std::vector<LString<char>> sequential(count);
+  std::vector<LString<char>> spawned(count);
+  std::vector<LString<char>> batched;
+
+  const auto sequentialSeconds = seconds([&]() {
+
+    for(size_t n = 0; n < count; ++n) {
+
+      sequential[n] = systems[n].generate(generations);
+    }
+  });
+
+  const auto spawnedSeconds = seconds([&]() {
+
+    parallelFor(count, [&](size_t n) { spawned[n] = systems[n].generate(generations); });
+  });
+
+  const auto batchSeconds = seconds([&]() { batched = LSystemBatch(threads).run(systems, generations); });
+
+  size_t symbols = 0;
+  bool identical = true;
+
+  for(size_t n = 0; n < count; ++n) {
+
+    symbols += sequential[n].size();
+    identical = identical && represent(batched[n]) == represent(sequential[n]) && represent(spawned[n]) == represent(sequential[n]);
+  }
+
+  std::cout << "method,systems,symbols,seconds,systems_per_second,identical\n";
+
+  for(const auto& [method, elapsed] : {std::pair{"sequential", sequentialSeconds}, std::pair{"thread_per_system", spawnedSeconds}, std::pair{"batch", batchSeconds}}) {
+
+    std::cout << method << ',' << count << ',' << symbols << ',' << elapsed << ',' << static_cast<double>(count) / elapsed << ',' << identical << '\n';
+  }
+
+  return 0;
+}
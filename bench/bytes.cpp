@@ -0,0 +1,82 @@
+//Measures parameterless char systems generated by LSystem, by LByteSystem, and by LStaticSystem where the grammar is fixed
+//Usage: bytes_bench [generations]
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <cassert>
+#include <stdlib.h>
+#include <vector>
+
+#include "l_system/l_bytes.h"
+
+using namespace l_system;
+
+using Algae = LStaticSystem<LStaticAxiom<char, 'A'>, LStaticRule<char, 'A', 'A', 'B'>, LStaticRule<char, 'B', 'A'>>;
+
+using Plant = LStaticSystem<LStaticAxiom<char, 'X'>,
+  LStaticRule<char, 'X', 'F', '+', '[', '[', 'X', ']', '-', 'X', ']', '-', 'F', '[', '-', 'F', 'X', ']', '+', 'X'>,
+  LStaticRule<char, 'F', 'F', 'F'>>;
+
+//the dragon curve, most of whose symbols are kept as they are
+using Dragon = LStaticSystem<LStaticAxiom<char, 'F', 'X'>,
+  LStaticRule<char, 'X', 'X', '+', 'Y', 'F', '+'>,
+  LStaticRule<char, 'Y', '-', 'F', 'X', '-', 'Y'>>;
+
+template <typename F>
+auto seconds(F&& f) -> double {
+
+  const auto start = std::chrono::steady_clock::now();
+
+  f();
+
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  return elapsed.count();
+}
+
+template <typename System>
+void run(const char* workload, int generations) {
+
+  const auto system = System::toSystem();
+  const auto engine = LByteSystem::from(system);
+
+  assert(engine && "every workload has a byte engine.");
+
+  LString<char> dynamic;
+  LStaticString<char> bytes;
+  LStaticString<char> fixed;
+
+  const auto dynamicSeconds = seconds([&]() { dynamic = system.generate(generations); });
+  const auto bytesSeconds = seconds([&]() { bytes = engine->generate(generations); });
+  const auto staticSeconds = seconds([&]() { fixed = System::generate(generations); });
+
+  //every generation along the way is written, so the bytes rewritten are the sum of their lengths
+  double written = 0.0;
+
+  for(int i = 1; i <= generations; ++i) {
+
+    written += static_cast<double>(System::length(i));
+  }
+
+  const bool identical = represent(bytes) == represent(dynamic) && represent(bytes) == represent(fixed);
+
+  for(const auto& [path, elapsed] : {std::pair{"lsystem", dynamicSeconds}, std::pair{"bytes", bytesSeconds}, std::pair{"static", staticSeconds}}) {
+
+    std::cout << workload << ',' << path << ',' << bytes.size() << ',' << elapsed << ',' << written / elapsed / 1e6 << ',' << identical << '\n';
+  }
+}
+
+int main(int argc, char const *argv[]) {
+
+  int generations = (argc >= 2) ? static_cast<int>(strtol(argv[1], nullptr, 0)) : 30;
+  assert(generations >= 0 && "Usage: bytes_bench [generations]");
+
+  std::cout << "workload,path,symbols,seconds,megabytes_per_second,identical\n";
+
+  run<Algae>("algae", generations);
+  run<Plant>("plant", std::max(1, generations / 4));
+  run<Dragon>("dragon", std::max(1, generations * 2 / 3));
+
+  return 0;
+}
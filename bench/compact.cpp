@@ -0,0 +1,66 @@
+//Compares the memory footprint, generation and scan speed of LString and LCompactString for a generated algae system
+
+#include <chrono>
+#include <iostream>
+#include <cassert>
+#include <stdlib.h>
+
+#include "l_system/l_system.h"
+#include "l_system/l_compact.h"
+
+using namespace l_system;
+
+template <typename F>
+auto seconds(F&& f) -> double {
+
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  return elapsed.count();
+}
+
+int main(int argc, char const *argv[]) {
+
+  int generations = (argc >= 2) ? static_cast<int>(strtol(argv[1], nullptr, 0)) : 25;
+  assert(generations >= 0 && "Usage: compact_bench [generations]");
+
+  LSymbolType A('A');
+  LSymbolType B('B');
+
+  LSystem<char> algae({LSymbol(A)});
+  algae.addRule(LRule(A, {A, B}));
+  algae.addRule(LRule(B, {A}));
+
+  LString<char> lstring;
+  LCompactString<char> compact;
+
+  const auto lstringGenerate = seconds([&]() { lstring = algae.generate(generations); });
+  const auto compactGenerate = seconds([&]() { compact = algae.generateCompact(generations); });
+
+  size_t counted = 0;
+
+  const auto lstringScan = seconds([&]() {
+
+    for(const auto& symbol : lstring) {
+
+      counted += symbol.type().representation() == 'A';
+    }
+  });
+
+  const auto compactScan = seconds([&]() {
+
+    for(size_t i = 0; i < compact.size(); ++i) {
+
+      counted += compact.type(i).representation() == 'A';
+    }
+  });
+
+  const auto size = static_cast<double>(lstring.size());
+
+  std::cout << "container,symbols,bytes_per_symbol,generate_seconds,scan_seconds\n";
+  std::cout << "LString," << lstring.size() << ',' << static_cast<double>(lstring.capacity() * sizeof(LSymbol<char>)) / size << ',' << lstringGenerate << ',' << lstringScan << '\n';
+  std::cout << "LCompactString," << compact.size() << ',' << static_cast<double>(compact.memoryUsage()) / size << ',' << compactGenerate << ',' << compactScan << '\n';
+
+  return (counted > 0) ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+//Compares writing a generated string through an ostream symbol by symbol with represent and with format into sinks, for a plain and a parametric system
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <cassert>
+#include <stdlib.h>
+
+#include "l_system/l_system.h"
+
+using namespace l_system;
+
+template <typename F>
+auto seconds(F&& f) -> double {
+
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  return elapsed.count();
+}
+
+template <typename T>
+void compare(const char* name, const LString<T>& lstring, unsigned threads) {
+
+  std::string streamed;
+  std::string represented;
+  std::string formatted;
+
+  const auto streamSeconds = seconds([&]() {
+
+    std::ostringstream stream;
+
+    for(const auto& symbol : lstring) {
+
+      representSymbol(stream, symbol, true);
+    }
+
+    streamed = stream.str();
+  });
+
+  const auto representSeconds = seconds([&]() { represented = represent(lstring, true); });
+
+  const auto formatSeconds = seconds([&]() {
+
+    LStringSink sink(formatted);
+    format(sink, lstring, true, threads);
+  });
+
+  assert(streamed == represented && streamed == formatted && "formatting must give the text of representSymbol.");
+
+  std::cout << name << ',' << lstring.size() << ',' << streamed.size() << ',' << streamSeconds << ',' << representSeconds << ',' << formatSeconds << '\n';
+}
+
+int main(int argc, char const *argv[]) {
+
+  int generations = (argc >= 2) ? static_cast<int>(strtol(argv[1], nullptr, 0)) : 25;
+  unsigned threads = (argc >= 3) ? static_cast<unsigned>(strtoul(argv[2], nullptr, 0)) : 4;
+  assert(generations >= 0 && "Usage: format_bench [generations] [threads]");
+
+  LSymbolType A('A');
+  LSymbolType B('B');
+
+  LSystem<char> algae({LSymbol(A)});
+  algae.addRule(LRule(A, {A, B}));
+  algae.addRule(LRule(B, {A}));
+
+  LSymbolType F('F', parameterSet(0, 1, 1));
+
+  LSymbol<char> seed(F);
+  seed.setFloatParam(1.0f, 0);
+
+  LSystem<char> parametric({seed});
+  LRule<char> grow(F, {F, B, F});
+
+  grow.setParameter(0, LINT, 0, intParam(0) + 1);
+  grow.setParameter(0, LFLOAT, 0, floatParam(0) * 0.75f);
+  grow.setParameter(2, LINT, 0, intParam(0) - 3);
+  grow.setParameter(2, LFLOAT, 0, floatParam(0) / 3.0f);
+  parametric.addRule(grow);
+
+  std::cout << "system,symbols,characters,stream_seconds,represent_seconds,format_seconds\n";
+
+  compare("algae", algae.generate(generations), threads);
+  compare("parametric", parametric.generate(generations - 7), threads);
+
+  return 0;
+}
@@ -0,0 +1,89 @@
+//Measures generation throughput as the number of rules in a system grows
+//The compiled rule table should keep throughput flat, where scanning every rule for every symbol degrades linearly
+
+#include <chrono>
+#include <iostream>
+#include <cassert>
+#include <stdlib.h>
+
+#include "l_system/l_system.h"
+
+using namespace l_system;
+
+//a system over ruleCount char symbols in which every symbol doubles, so output length is independent of the rule count
+auto makeSystem(int ruleCount) -> LSystem<char> {
+
+  LSystem<char> system({LSymbol(LSymbolType(static_cast<char>(0)))});
+
+  for(int i = 0; i < ruleCount; ++i) {
+
+    LSymbolType predecessor(static_cast<char>(i));
+    LSymbolType first(static_cast<char>((i + 1) % ruleCount));
+    LSymbolType second(static_cast<char>((i * 7 + 3) % ruleCount));
+
+    system.addRule(LRule(predecessor, {first, second}));
+  }
+
+  return system;
+}
+
+//the pre-dispatch generation loop, kept as a reference point
+auto scanGenerate(const LSystem<char>& system, int generations) -> LString<char> {
+
+  auto current = system.axiom();
+  const auto rules = system.rules();
+
+  for(int i = 0; i < generations; ++i) {
+
+    LString<char> next;
+
+    for(const auto& symbol : current) {
+
+      LString<char> replacement = {symbol};
+
+      for(const auto& rule : rules) {
+
+        if(rule.applies(symbol)) {
+
+          replacement = rule.produce(symbol);
+        }
+      }
+
+      next.insert(next.end(), replacement.begin(), replacement.end());
+    }
+
+    current = std::move(next);
+  }
+
+  return current;
+}
+
+template <typename F>
+auto symbolsPerSecond(F&& generate) -> double {
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto produced = generate().size();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  return static_cast<double>(produced * 2) / elapsed.count(); //a doubling system rewrites about twice its final length in total
+}
+
+int main(int argc, char const *argv[]) {
+
+  int generations = (argc >= 2) ? static_cast<int>(strtol(argv[1], nullptr, 0)) : 18;
+  assert(generations >= 0 && "Usage: rules_bench [generations]");
+
+  std::cout << "rules,compiled_symbols_per_second,scan_symbols_per_second\n";
+
+  for(int ruleCount : {1, 4, 16, 64, 128, 256}) {
+
+    const auto system = makeSystem(ruleCount);
+
+    const auto compiled = symbolsPerSecond([&]() { return system.generate(generations); });
+    const auto scanned = symbolsPerSecond([&]() { return scanGenerate(system, generations); });
+
+    std::cout << ruleCount << ',' << compiled << ',' << scanned << '\n';
+  }
+
+  return 0;
+}
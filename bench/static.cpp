@@ -0,0 +1,76 @@
+//Measures a fixed grammar generated by LSystem, by LStaticSystem, and a memcpy of its output for reference
+//Usage: static_bench [generations]
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <cassert>
+#include <stdlib.h>
+#include <vector>
+
+#include "l_system/l_static.h"
+
+using namespace l_system;
+
+using Algae = LStaticSystem<LStaticAxiom<char, 'A'>, LStaticRule<char, 'A', 'A', 'B'>, LStaticRule<char, 'B', 'A'>>;
+
+using Plant = LStaticSystem<LStaticAxiom<char, 'X'>,
+  LStaticRule<char, 'X', 'F', '+', '[', '[', 'X', ']', '-', 'X', ']', '-', 'F', '[', '-', 'F', 'X', ']', '+', 'X'>,
+  LStaticRule<char, 'F', 'F', 'F'>>;
+
+template <typename F>
+auto seconds(F&& f) -> double {
+
+  const auto start = std::chrono::steady_clock::now();
+
+  f();
+
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  return elapsed.count();
+}
+
+template <typename System>
+void run(const char* workload, int generations) {
+
+  const auto system = System::toSystem();
+
+  LString<char> dynamic;
+  LStaticString<char> fixed;
+
+  const auto dynamicSeconds = seconds([&]() { dynamic = system.generate(generations); });
+  const auto staticSeconds = seconds([&]() { fixed = System::generate(generations); });
+
+  std::vector<char> copy(fixed.size());
+  const auto copySeconds = seconds([&]() { memcpy(copy.data(), fixed.data(), fixed.size()); });
+
+  //every generation along the way is written, so the bytes rewritten are the sum of their lengths
+  double bytes = 0.0;
+
+  for(int i = 1; i <= generations; ++i) {
+
+    bytes += static_cast<double>(System::length(i));
+  }
+
+  const bool identical = represent(fixed) == represent(dynamic);
+
+  for(const auto& [path, elapsed] : {std::pair{"lsystem", dynamicSeconds}, std::pair{"static", staticSeconds}}) {
+
+    std::cout << workload << ',' << path << ',' << fixed.size() << ',' << elapsed << ',' << bytes / elapsed / 1e6 << ',' << identical << '\n';
+  }
+
+  std::cout << workload << ",memcpy_last," << fixed.size() << ',' << copySeconds << ',' << static_cast<double>(fixed.size()) / copySeconds / 1e6 << ",1\n";
+}
+
+int main(int argc, char const *argv[]) {
+
+  int generations = (argc >= 2) ? static_cast<int>(strtol(argv[1], nullptr, 0)) : 30;
+  assert(generations >= 0 && "Usage: static_bench [generations]");
+
+  std::cout << "workload,path,symbols,seconds,megabytes_per_second,identical\n";
+
+  run<Algae>("algae", generations);
+  run<Plant>("plant", std::max(1, generations / 4));
+
+  return 0;
+}
@@ -0,0 +1,311 @@
+//A standard set of workloads over the generation, arena generation, compact generation, represent and parameter access paths
+//Prints one csv row per workload and path, with throughput, memory per symbol, allocations and peak resident memory
+//Usage: suite_bench [workload], where workload runs only the workloads whose name starts with it
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "l_system/l_system.h"
+
+using namespace l_system;
+
+//every allocation of the process is counted, so that a path's allocations are the difference of the count around it
+static std::atomic<size_t> allocations(0);
+
+auto operator new(size_t size) -> void* {
+
+  allocations.fetch_add(1, std::memory_order_relaxed);
+
+  if(auto* memory = std::malloc(size == 0 ? 1 : size)) {
+
+    return memory;
+  }
+
+  throw std::bad_alloc();
+}
+
+auto operator new[](size_t size) -> void* {
+
+  return operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+
+  std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+
+  std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+
+  std::free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+
+  std::free(memory);
+}
+
+//resets the peak resident memory where the kernel allows it, otherwise peaks only grow over the run
+void resetPeak() {
+
+  std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+//the peak resident memory in kilobytes
+auto peakKilobytes() -> long {
+
+  std::ifstream status("/proc/self/status");
+
+  for(std::string line; std::getline(status, line);) {
+
+    if(line.compare(0, 6, "VmHWM:") == 0) {
+
+      return std::strtol(line.c_str() + 6, nullptr, 10);
+    }
+  }
+
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+
+  return usage.ru_maxrss;
+}
+
+struct Measurement {
+
+  double seconds;
+  size_t allocations;
+  long peak;
+};
+
+template <typename F>
+auto measure(F&& f) -> Measurement {
+
+  resetPeak();
+
+  const auto allocated = allocations.load();
+  const auto start = std::chrono::steady_clock::now();
+
+  f();
+
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  return {elapsed.count(), allocations.load() - allocated, peakKilobytes()};
+}
+
+void report(const std::string& workload, const char* path, size_t symbols, double bytes, const Measurement& measurement, double passes) {
+
+  std::cout << workload << ',' << path << ',' << symbols << ',' << measurement.seconds << ',' << static_cast<double>(symbols) / measurement.seconds << ','
+    << bytes / static_cast<double>(symbols) << ',' << static_cast<double>(measurement.allocations) / passes << ',' << measurement.peak << '\n';
+}
+
+//the bytes a string holds, symbols and their parameter data, whichever allocator the string uses
+template <typename T, typename Allocator>
+auto footprint(const std::vector<LSymbol<T>, Allocator>& lstring) -> double {
+
+  auto bytes = lstring.capacity() * sizeof(LSymbol<T>);
+
+  for(const auto& symbol : lstring) {
+
+    bytes += symbol.parameters().size();
+  }
+
+  return static_cast<double>(bytes);
+}
+
+//reads every parameter of every symbol through LParameterData
+template <typename T>
+auto readParameters(const LString<T>& lstring) -> double {
+
+  double sum = 0.0;
+
+  for(const auto& symbol : lstring) {
+
+    const auto& parameters = symbol.parameters();
+
+    for(LParameterCount i = 0; i < parameterCount(parameters.set(), LCHAR); ++i) {
+
+      sum += parameters.getChar(i);
+    }
+    for(LParameterCount i = 0; i < parameterCount(parameters.set(), LINT); ++i) {
+
+      sum += parameters.getInt(i);
+    }
+    for(LParameterCount i = 0; i < parameterCount(parameters.set(), LFLOAT); ++i) {
+
+      sum += static_cast<double>(parameters.getFloat(i));
+    }
+    for(LParameterCount i = 0; i < parameterCount(parameters.set(), LCUSTOM); ++i) {
+
+      for(auto byte : parameters.getCustom(i)) {
+
+        sum += byte;
+      }
+    }
+  }
+
+  return sum;
+}
+
+template <typename T, typename Hash>
+void run(const std::string& workload, const LSystem<T, Hash>& system, int generations) {
+
+  LString<T> lstring;
+  LCompactString<T, Hash> compact;
+  std::string text;
+  double sum = 0.0;
+
+  system.compiled(); //rules are compiled on first use, which is not what is measured
+
+  //the arena path runs first and its result is freed before the plain one, so neither path's peak holds the other's result
+  auto arenaString = std::make_unique<pmr::LString<T>>();
+
+  const auto arena = measure([&]() { *arenaString = system.generate(generations, 1, std::pmr::get_default_resource()); });
+  const auto arenaSymbols = arenaString->size();
+  const auto arenaBytes = footprint(*arenaString);
+
+  arenaString.reset();
+
+  const auto generated = measure([&]() { lstring = system.generate(generations); });
+  report(workload, "generate", lstring.size(), footprint(lstring), generated, generations);
+  report(workload, "generate_arena", arenaSymbols, arenaBytes, arena, generations);
+
+  const auto compacted = measure([&]() { compact = system.generateCompact(generations); });
+  report(workload, "generate_compact", compact.size(), static_cast<double>(compact.memoryUsage()), compacted, generations);
+
+  const auto represented = measure([&]() { text = represent(lstring, true); });
+  report(workload, "represent", lstring.size(), static_cast<double>(text.size()), represented, 1);
+
+  const auto accessed = measure([&]() { sum = readParameters(lstring); });
+  report(workload, "parameters", lstring.size(), footprint(lstring) - static_cast<double>(lstring.capacity() * sizeof(LSymbol<T>)), accessed, 1);
+
+  if(sum != sum) {
+
+    std::cerr << "unexpected parameter values in " << workload << '\n';
+  }
+}
+
+class Point {
+
+  int x_;
+  int y_;
+
+public:
+
+  Point(int x, int y) : x_(x), y_(y) {}
+  auto x() const { return x_; }
+  auto y() const { return y_; }
+
+  bool operator== (const Point& other) const {
+
+    return x() == other.x() && y() == other.y();
+  }
+
+  friend std::ostream& operator<< (std::ostream& stream, const Point& point) {
+
+    return stream << "(" << point.x() << ", " << point.y() << ")";
+  }
+};
+
+struct PointHash {
+
+  auto operator() (const Point& point) const noexcept -> size_t {
+
+    return std::hash<int>()(point.x()) * 31 + std::hash<int>()(point.y());
+  }
+};
+
+int main(int argc, char const *argv[]) {
+
+  const std::string only = (argc >= 2) ? argv[1] : "";
+  const auto selected = [&](const std::string& workload) { return workload.compare(0, only.size(), only) == 0; };
+
+  LSymbolType F('F');
+  LSymbolType X('X');
+  LSymbolType Y('Y');
+  LSymbolType left('+');
+  LSymbolType right('-');
+  LSymbolType push('[');
+  LSymbolType pop(']');
+
+  std::cout << "workload,path,symbols,seconds,symbols_per_second,bytes_per_symbol,allocations_per_generation,peak_rss_kb\n";
+
+  if(selected("algae")) {
+
+    LSymbolType A('A');
+    LSymbolType B('B');
+
+    LSystem<char> algae({LSymbol(A)});
+    algae.addRule(LRule(A, {A, B}));
+    algae.addRule(LRule(B, {A}));
+
+    run("algae", algae, 30);
+  }
+
+  if(selected("koch")) {
+
+    LSystem<char> koch({LSymbol(F)});
+    koch.addRule(LRule(F, {F, left, F, right, F, right, F, left, F}));
+
+    run("koch", koch, 8);
+  }
+
+  if(selected("dragon")) {
+
+    LSystem<char> dragon({LSymbol(F), LSymbol(X)});
+    dragon.addRule(LRule(X, {X, left, Y, F, left}));
+    dragon.addRule(LRule(Y, {right, F, X, right, Y}));
+
+    run("dragon", dragon, 20);
+  }
+
+  if(selected("plant")) {
+
+    LSystem<char> plant({LSymbol(X)});
+    plant.addRule(LRule(X, {F, left, push, push, X, pop, right, X, pop, right, F, push, right, F, X, pop, left, X}));
+    plant.addRule(LRule(F, {F, F}));
+
+    run("plant", plant, 8);
+  }
+
+  if(selected("point")) {
+
+    LSymbolType A(Point(5, 3));
+    LSymbolType B(Point(2, 6));
+
+    LSystem<Point, PointHash> points({LSymbol(A)});
+    points.addRule(LRule(A, {A, B}));
+    points.addRule(LRule(B, {A}));
+
+    run("point", points, 25);
+  }
+
+  if(selected("parameters")) {
+
+    //every kind of parameter at the most a symbol can hold
+    LSymbolType A('A', parameterSet(MAX_PARAMS, MAX_PARAMS, MAX_PARAMS, MAX_PARAMS), 4);
+    LSymbolType B('B', parameterSet(MAX_PARAMS, MAX_PARAMS, MAX_PARAMS, MAX_PARAMS), 4);
+
+    LSystem<char> heavy({LSymbol(A)});
+    heavy.addRule(LRule(A, {A, B}));
+    heavy.addRule(LRule(B, {A}));
+
+    run("parameters", heavy, 20);
+  }
+
+  return 0;
+}
@@ -0,0 +1,42 @@
+//Measures how generation of a large algae system scales with the number of threads
+
+#include <chrono>
+#include <iostream>
+#include <cassert>
+#include <stdlib.h>
+#include <thread>
+
+#include "l_system/l_system.h"
+
+using namespace l_system;
+
+int main(int argc, char const *argv[]) {
+
+  int generations = (argc >= 2) ? static_cast<int>(strtol(argv[1], nullptr, 0)) : 30;
+  unsigned maxThreads = (argc >= 3) ? static_cast<unsigned>(strtoul(argv[2], nullptr, 0)) : std::max(1u, std::thread::hardware_concurrency());
+  assert(generations >= 0 && "Usage: threads_bench [generations] [max threads]");
+
+  LSymbolType A('A');
+  LSymbolType B('B');
+
+  LSystem<char> algae({LSymbol(A)});
+  algae.addRule(LRule(A, {A, B}));
+  algae.addRule(LRule(B, {A}));
+
+  const auto reference = algae.generate(generations);
+
+  std::cout << "threads,symbols,seconds,symbols_per_second,identical\n";
+
+  for(unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto result = algae.generate(generations, threads);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const bool identical = represent(result) == represent(reference);
+
+    std::cout << threads << ',' << result.size() << ',' << elapsed.count() << ',' << static_cast<double>(result.size()) / elapsed.count() << ',' << identical << '\n';
+  }
+
+  return 0;
+}
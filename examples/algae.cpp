@@ -16,7 +16,7 @@ int main(int argc, char const *argv[]) {
 
   //define symbol types. Any type can be passed to the constructor, so long as they are hashable.
   LSymbolType A('A'); //true / false, 5 / 6, -0.33 / 99999.3, anything goes
-  LSymbolType B('B'); //if a custom type is used, a custom hash type can be passed to the LSystem constructor.
+  LSymbolType B('B'); //if a custom type is used, a custom hash type can be passed as the LSystem's second template argument.
 
   LSymbol A_(A); //define symbols needed for axiom and rules
   LSymbol B_(B);
@@ -33,6 +33,18 @@ int main(int argc, char const *argv[]) {
 
   std::cout << "Algae generation " << generation << ": " << represent(algae.generate(generation)) << '\n'; //generate a generation
 
+  std::cout << "Algae generation " << generation << " streamed: "; //generations can also be walked one symbol at a time, without holding them in memory
+
+  const auto stream = algae.stream(generation); //empty for rules which do not rewrite every symbol of a type alike
+  assert(stream && "algae's rules rewrite every symbol of a type alike.");
+
+  for(const auto& symbol : *stream) {
+
+    std::cout << symbol.type().representation();
+  }
+
+  std::cout << '\n';
+
   LSymbolType C('C'); //new symbol types can be designated on the fly
 
   LSymbol C_(C); //new symbols as well
@@ -0,0 +1,66 @@
+//Demonstration of the binary format, checkpointing a system and resuming it, then mapping a saved generation
+//Usage: checkpoint directory generation, the checkpoint is taken halfway and the files are left in the directory
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cassert>
+#include <stdlib.h>
+
+#include "l_system/l_system.h"
+
+int main(int argc, char const *argv[]) {
+
+  using namespace l_system;
+
+  assert(argc >= 3 && "Usage: checkpoint directory generation");
+  const std::string directory = argv[1];
+  int generation = static_cast<int>(strtol(argv[2], nullptr, 0));
+
+  LSymbolType apex('A', parameterSet(0, 1, 0)); //grows while its age is below 20
+  LSymbolType f('F');
+  LSymbolType push('[');
+  LSymbolType pop(']');
+
+  LSymbol<char> seedling(apex);
+  seedling.setIntParam(0, 0);
+
+  LSystem<char> plant({seedling});
+  LRule<char> grow(apex, {f, push, apex, pop, apex});
+
+  grow.setGuard(intParam(0) < 20);
+  grow.setParameter(2, LINT, 0, intParam(0) + 1);
+  grow.setParameter(4, LINT, 0, intParam(0) + 2);
+
+  plant.addRule(grow);
+  plant.setSeed(42);
+
+  //the system and its halfway generation go into one file
+  {
+    std::ofstream out(directory + "/plant.lsys", std::ios::binary);
+    const bool saved = plant.save(out, generation / 2, plant.generate(generation / 2));
+    assert(saved && "could not write the checkpoint.");
+  }
+
+  std::ifstream in(directory + "/plant.lsys", std::ios::binary);
+  auto resumed = LSystem<char>::load(in);
+  assert(resumed && "could not read the checkpoint.");
+
+  //the loaded system only rewrites from the checkpoint on
+  auto lstring = resumed->generate(generation);
+  assert(represent(lstring, true) == represent(plant.generate(generation), true) && "resumed generation must match.");
+
+  {
+    std::ofstream out(directory + "/plant.lstr", std::ios::binary);
+    save(out, lstring);
+  }
+
+  //a mapped string reads its symbols straight from the file
+  auto mapped = LMappedString<char>::open(directory + "/plant.lstr");
+  assert(mapped && mapped->size() == lstring.size() && "could not map the generation.");
+
+  std::cout << "Rule: " << resumed->rules().front().representation() << '\n';
+  std::cout << "Generation " << generation << " (" << mapped->size() << " symbols), resumed from generation " << generation / 2 << '\n';
+
+  return 0;
+}
@@ -0,0 +1,44 @@
+//Demonstration of context sensitive rules, with a signal propagating along a branching filament
+//A rule left < predecessor > right only rewrites predecessor where it is preceded by left and followed by right
+
+#include <iostream>
+#include <cassert>
+#include <stdlib.h>
+
+#include "l_system/l_system.h"
+
+int main(int argc, char const *argv[]) {
+
+  using namespace l_system;
+
+  assert(argc >= 2 && "Usage: context generation");
+  int generation = static_cast<int>(strtol(argv[1], nullptr, 0));
+
+  LSymbolType a('a'); //a cell
+  LSymbolType b('b'); //a cell carrying the signal
+  LSymbolType push('['); //branches
+  LSymbolType pop(']');
+  LSymbolType turn('+'); //a symbol without meaning for the signal
+
+  LSystem<char> filament({LSymbol(b), LSymbol(a), LSymbol(push), LSymbol(turn), LSymbol(a), LSymbol(a), LSymbol(pop), LSymbol(a), LSymbol(turn), LSymbol(a)});
+
+  filament.setBranchSymbols(push, pop); //contexts skip over branches, and branches see the context they grow from
+  filament.ignoreInContext(turn); //contexts look through ignored symbols
+
+  filament.addRule(LRule<char>({b}, a, {}, {b})); //b < a -> b, the signal moves into a cell preceded by one carrying it
+  filament.addRule(LRule(b, {a})); //b -> a, and leaves the cell it was in
+
+  std::cout << "Axiom: " << represent(filament.axiom()) << '\n';
+
+  for(const auto& rule : filament.rules()) {
+
+    std::cout << "Rule: " << rule.representation() << '\n';
+  }
+
+  filament.generateSeries(generation, [](int n, const LString<char>& lstring) {
+
+    std::cout << "Generation " << n << ": " << represent(lstring) << '\n';
+  });
+
+  return 0;
+}
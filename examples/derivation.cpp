@@ -0,0 +1,55 @@
+//Demonstration of a derivation DAG, which holds a generation far too long for memory and produces any part of it on demand
+//Usage: derivation generation
+
+#include <iostream>
+#include <cassert>
+#include <stdlib.h>
+
+#include "l_system/l_dag.h"
+
+int main(int argc, char const *argv[]) {
+
+  using namespace l_system;
+
+  assert(argc >= 2 && "Usage: derivation generation");
+  int generation = static_cast<int>(strtol(argv[1], nullptr, 0));
+
+  LSymbolType A('A');
+  LSymbolType B('B');
+
+  LSystem algae({LSymbol(A)});
+
+  algae.addRule(LRule(A, {A, B}));
+  algae.addRule(LRule(B, {A}));
+
+  auto derived = LDerivation<char>::derive(algae, generation); //only the length of each (type, depth) node is kept
+  assert(derived && "algae's rules rewrite every symbol of a type alike.");
+
+  const auto& derivation = *derived;
+
+  auto length = derivation.length();
+
+  if(!length) {
+
+    std::cout << "Generation " << generation << " is too long to count." << '\n';
+    return 0;
+  }
+
+  std::cout << "Generation " << generation << ": " << *length << " symbols from " << derivation.nodeCount() << " nodes" << '\n';
+  std::cout << "Last symbol: " << derivation.at(*length - 1).type().representation() << '\n'; //single symbols are found by descending the DAG
+
+  //a slice is iterated lazily, producing none of the symbols around it
+  std::cout << "Middle 10 symbols: ";
+
+  for(const auto& symbol : derivation.slice(*length / 2, *length / 2 + 10)) {
+
+    std::cout << symbol.type().representation();
+  }
+
+  std::cout << '\n';
+
+  //and can be copied out as an ordinary string
+  std::cout << "First 10 symbols: " << represent(derivation.materialize(0, 10)) << '\n';
+
+  return 0;
+}
@@ -0,0 +1,47 @@
+//Demonstration of generating on disk, where memory use is set by a budget rather than by the length of the generation
+//Usage: disk directory generation budget, the last generation is left in the directory as chunk files
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <stdlib.h>
+
+#include "l_system/l_system.h"
+
+int main(int argc, char const *argv[]) {
+
+  using namespace l_system;
+
+  assert(argc >= 4 && "Usage: disk directory generation budget");
+  const std::string directory = argv[1];
+  int generation = static_cast<int>(strtol(argv[2], nullptr, 0));
+  auto budget = static_cast<size_t>(strtoull(argv[3], nullptr, 0));
+
+  LSymbolType a('a');
+  LSymbolType b('b');
+
+  LSystem<char> algae({LSymbol(a)});
+
+  algae.addRule(LRule<char>(a, {a, b}));
+  algae.addRule(LRule<char>(b, {a}));
+
+  auto lstring = algae.generateOnDisk(generation, directory, budget, 4);
+  assert(lstring && "could not write the generation.");
+
+  std::cout << "Generation " << generation << ": " << lstring->size() << " symbols in " << lstring->chunks() << " chunks\n";
+
+  //a chunk can be mapped and read on its own
+  auto first = lstring->chunk(0);
+  assert(first && "could not map the first chunk.");
+
+  std::cout << "First chunk: " << first->size() << " symbols, starting ";
+
+  for(size_t i = 0; i < std::min<size_t>(first->size(), 16); ++i) {
+
+    std::cout << first->type(i).representation();
+  }
+
+  std::cout << '\n';
+
+  return 0;
+}
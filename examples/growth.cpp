@@ -0,0 +1,51 @@
+//Demonstration of analyzing an L-System's growth without generating it
+//Lengths, symbol counts and individual symbols of generations far too large to hold in memory can be computed exactly
+
+#include <iostream>
+#include <cassert>
+#include <stdlib.h>
+
+#include "l_system/l_growth.h"
+
+int main(int argc, char const *argv[]) {
+
+  using namespace l_system;
+
+  assert(argc >= 2 && "Usage: growth generation");
+  int generation = static_cast<int>(strtol(argv[1], nullptr, 0));
+
+  LSymbolType A('A');
+  LSymbolType B('B');
+
+  LSystem algae({LSymbol(A)});
+
+  algae.addRule(LRule(A, {A, B}));
+  algae.addRule(LRule(B, {A}));
+
+  auto analyzed = LGrowth<char>::analyze(algae); //the analyzer takes a snapshot of the system's axiom and rules, if they are deterministic and context free
+  assert(analyzed && "algae's rules rewrite every symbol of a type alike.");
+
+  const auto& growth = *analyzed;
+
+  auto length = growth.length(generation); //lengths are exact, and empty if they would overflow
+
+  if(!length) {
+
+    std::cout << "Generation " << generation << " is too long to count." << '\n';
+    return 0;
+  }
+
+  std::cout << "Generation " << generation << " length: " << *length << '\n';
+
+  auto histogram = *growth.histogram(generation); //as are the counts of each symbol type
+
+  for(size_t i = 0; i < growth.types().size(); ++i) {
+
+    std::cout << growth.types()[i].representation() << ": " << histogram[i] << '\n';
+  }
+
+  std::cout << "Last symbol: " << growth.symbolAt(generation, *length - 1)->type().representation() << '\n'; //single symbols can be looked up
+  std::cout << "Middle 10 symbols: " << represent(growth.slice(generation, *length / 2, *length / 2 + 10)) << '\n'; //and so can ranges
+
+  return 0;
+}
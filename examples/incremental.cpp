@@ -0,0 +1,59 @@
+//Demonstration of editing a system interactively, where each edit rewrites only the symbols it affects
+//Usage: incremental generation
+
+#include <chrono>
+#include <iostream>
+#include <cassert>
+#include <stdlib.h>
+
+#include "l_system/l_incremental.h"
+
+int main(int argc, char const *argv[]) {
+
+  using namespace l_system;
+
+  assert(argc >= 2 && "Usage: incremental generation");
+  int generation = static_cast<int>(strtol(argv[1], nullptr, 0));
+
+  LSymbolType X('X');
+  LSymbolType F('F');
+  LSymbolType L('L'); //a leaf
+  LSymbolType left('+');
+  LSymbolType right('-');
+  LSymbolType push('[');
+  LSymbolType pop(']');
+
+  LSystem<char> plant({LSymbol(X)});
+  plant.addRule(LRule(X, {F, left, push, push, X, pop, right, X, pop, right, F, push, right, F, X, pop, left, X}));
+  plant.addRule(LRule(F, {F, F}));
+
+  const auto timed = [](auto&& edit) {
+
+    const auto start = std::chrono::steady_clock::now();
+
+    edit();
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return elapsed.count();
+  };
+
+  std::optional<LIncremental<char>> incremental;
+
+  const auto cold = timed([&]() { incremental.emplace(plant, generation); });
+  std::cout << "Derived " << incremental->result().size() << " symbols in " << cold << "s, rewriting " << incremental->rewritten() << '\n';
+
+  //only symbols descending from a + are rewritten, every F and X subtree is spliced from before
+  const auto leaves = timed([&]() { incremental->addRule(LRule(left, {left, L})); });
+  std::cout << "Rule " << incremental->system().rules().back().representation() << ": " << leaves << "s, rewriting " << incremental->rewritten() << '\n';
+
+  const auto axiom = timed([&]() { incremental->setAxiom({LSymbol(X), LSymbol(F)}); });
+  std::cout << "Axiom " << represent(incremental->generation(0)) << ": " << axiom << "s, rewriting " << incremental->rewritten() << '\n';
+
+  plant.addRule(LRule(left, {left, L}));
+  plant.setAxiom({LSymbol(X), LSymbol(F)});
+
+  assert(represent(incremental->result()) == represent(plant.generate(generation)) && "an incremental derivation must match generating from scratch.");
+
+  return 0;
+}
@@ -4,6 +4,7 @@
 #include <iomanip>
 
 #include "l_system/l_param.h"
+#include "l_system/l_schema.h"
 
 int main() {
 
@@ -54,5 +55,14 @@ int main() {
   b.setCustom({0xFE, 0xDC, 0xBA, 0x98, 0x76, 0x54}, 7); //custom data - must be exact number of bytes specified at construction
   std::cout << represent(b.getCustom(7)) << '\n'; //represent can display raw values for custom data, but you could also pass to a constructor for your data type
   std::cout << represent(b.getCustom(7), false) << '\n'; //can also print without spacing
+
+  LParams<LCHAR, LINT, LFLOAT, LCUSTOM> c; //a parameter set can also be fixed at compile time, with constant offsets and inline storage
+
+  c.setInt<0>(-1359); //positions are template arguments, out of bounds access fails to compile
+  c.setFloat<0>(53.122f);
+  std::cout << c.getInt<0>() << ' ' << c.getFloat<0>() << '\n';
+
+  std::cout << (LParams<LCHAR, LINT, LFLOAT, LCUSTOM>::set == oneOfEach) << '\n'; //its layout matches the runtime set with the same parameters
+  std::cout << c.toData().getFloat(0) << '\n'; //so it converts to and from LParameterData by copying bytes
   return 0;
 }
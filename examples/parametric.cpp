@@ -0,0 +1,49 @@
+//Demonstration of parametric rules, with an apex which grows internodes of shrinking length until it runs out of steps
+//A guard decides whether a rule applies to a symbol, and expressions compute the parameters of what it produces
+
+#include <iostream>
+#include <cassert>
+#include <stdlib.h>
+
+#include "l_system/l_system.h"
+
+int main(int argc, char const *argv[]) {
+
+  using namespace l_system;
+
+  assert(argc >= 2 && "Usage: parametric generation");
+  int generation = static_cast<int>(strtol(argv[1], nullptr, 0));
+
+  LSymbolType apex('A', parameterSet(0, 1, 1)); //an apex with its remaining steps and the length of its next internode
+  LSymbolType internode('F', parameterSet(0, 0, 1)); //an internode of some length
+  LSymbolType flower('K'); //what an apex turns into once out of steps
+
+  LSymbol<char> seedling(apex);
+  seedling.setIntParam(4, 0);
+  seedling.setFloatParam(1.0f, 0);
+
+  LSystem<char> plant({seedling});
+
+  LRule<char> bloom(apex, {flower}); //A -> K, applies wherever the rule below does not
+
+  LRule<char> grow(apex, {internode, apex}); //A(s, l) : s > 0 -> F(l) A(s - 1, l * 0.6)
+  grow.setGuard(intParam(0) > 0);
+  grow.setParameter(0, LFLOAT, 0, floatParam(0));
+  grow.setParameter(1, LINT, 0, intParam(0) - 1);
+  grow.setParameter(1, LFLOAT, 0, floatParam(0) * 0.6f);
+
+  plant.addRule(bloom);
+  plant.addRule(grow); //later rules are tried first
+
+  for(const auto& rule : plant.rules()) {
+
+    std::cout << "Rule: " << rule.representation() << '\n';
+  }
+
+  plant.generateSeries(generation, [](int n, const LString<char>& lstring) {
+
+    std::cout << "Generation " << n << ": " << represent(lstring, true) << '\n';
+  });
+
+  return 0;
+}
@@ -6,6 +6,7 @@
 #include <cassert>
 #include <stdlib.h>
 #include <ostream>
+#include <functional>
 #include "l_system/l_system.h"
 
 class Point { //a simple 2D point class
@@ -19,7 +20,7 @@ public:
   auto x() const { return x_; }
   auto y() const { return y_; }
 
-  bool operator== (const Point& other) { //Point must have an equality operator
+  bool operator== (const Point& other) const { //Point must have an equality operator
 
     return x() == other.x() && y() == other.y();
   }
@@ -32,6 +33,14 @@ public:
   }
 };
 
+struct PointHash { //a hash for Point is optional, but lets the system intern Points with a hash table rather than a scan
+
+  auto operator() (const Point& point) const noexcept -> size_t {
+
+    return std::hash<int>()(point.x()) * 31 + std::hash<int>()(point.y());
+  }
+};
+
 int main(int argc, char const *argv[]) {
 
   using namespace l_system;
@@ -48,7 +57,7 @@ int main(int argc, char const *argv[]) {
   LRule A_AB(A, {A, B}); //define rules
   LRule B_A(B, {A});
 
-  LSystem<Point> points({LSymbol(A)}); //custom hash types require explicit template declaration for the LSystem type
+  LSystem<Point, PointHash> points({LSymbol(A)}); //custom hash types require explicit template declaration for the LSystem type
 
   points.addRule(A_AB); //add the rules to the system
   points.addRule(B_A);
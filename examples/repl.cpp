@@ -10,7 +10,7 @@ using namespace l_system;
 //helper functions
 constexpr bool isValidSymbol(char c) {
 
-  constexpr const auto invalid = {' ', '-', '>', '!', '(', ')'};
+  constexpr const char invalid[] = {' ', '-', '>', '!', '(', ')'};
 
   for(auto in : invalid) {
 
@@ -46,6 +46,7 @@ int main() {
   bool startup = true;
 
   LSystem<char> system({});
+  system.setCacheLimit(64 << 20); //keep up to 64MB of generations, so asking for a deeper generation continues from the last one
 
   for(std::string input; input != "exit"; std::cin >> input) {
 
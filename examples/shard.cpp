@@ -0,0 +1,68 @@
+//Demonstration of generating one generation as shards, each of which could come from a different process or machine
+//Usage: shard directory generation shards [shard], writes only the given shard if one is given, otherwise every shard, and checks them once all are written
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <stdlib.h>
+
+#include "l_system/l_shard.h"
+
+int main(int argc, char const *argv[]) {
+
+  using namespace l_system;
+
+  assert(argc >= 4 && "Usage: shard directory generation shards [shard]");
+  const std::string directory = argv[1];
+  int generation = static_cast<int>(strtol(argv[2], nullptr, 0));
+  auto count = static_cast<size_t>(strtoull(argv[3], nullptr, 0));
+
+  LSymbolType a('a');
+  LSymbolType b('b');
+
+  LSystem<char> algae({LSymbol(a)});
+
+  algae.addRule(LRule<char>(a, {a, b}));
+  algae.addRule(LRule<char>(b, {a}));
+
+  //every process plans the same shards from the system alone
+  auto shards = LShards<char>::plan(algae, generation, count);
+  assert(shards && "algae can be sharded while its length fits in an LCount.");
+
+  if(argc >= 5) {
+
+    auto k = static_cast<size_t>(strtoull(argv[4], nullptr, 0));
+    assert(k < count && "the shard must be less than the number of shards.");
+
+    const auto range = shards->range(k);
+    const auto written = shards->write(directory, k);
+    assert(written && "could not write the shard.");
+
+    std::cout << "Shard " << k << " of " << count << ": symbols " << range.begin << " to " << range.end << " in " << shards->file(k) << '\n';
+
+    return 0;
+  }
+
+  bool written = shards->writeManifest(directory);
+
+  for(size_t k = 0; k < count; ++k) {
+
+    written = shards->write(directory, k) && written;
+  }
+
+  assert(written && "could not write the shards.");
+
+  //once every shard is written, the manifest puts them back together as one generation on disk
+  const auto manifest = LShardManifest::open(directory, generation);
+  assert(manifest && "could not read the manifest.");
+
+  const auto assembled = manifest->assemble<char>(directory);
+  assert(assembled && "a shard is missing.");
+
+  std::cout << "Generation " << generation << ": " << assembled->size() << " symbols in " << assembled->chunks() << " shards\n";
+
+  const auto whole = assembled->materialize();
+  assert(whole && represent(*whole) == represent(algae.generate(generation)) && "the shards must concatenate to the generation.");
+
+  return 0;
+}
@@ -0,0 +1,29 @@
+//Demonstration of a system fixed at compile time, whose generation lengths are known to the compiler
+
+#include <iostream>
+#include <cassert>
+#include <stdlib.h>
+
+#include "l_system/l_static.h"
+
+int main(int argc, char const *argv[]) {
+
+  using namespace l_system;
+
+  assert(argc >= 2 && "Usage: static generation");
+  int generation = static_cast<int>(strtol(argv[1], nullptr, 0));
+
+  //A -> AB, B -> A, from the axiom A
+  using Algae = LStaticSystem<LStaticAxiom<char, 'A'>, LStaticRule<char, 'A', 'A', 'B'>, LStaticRule<char, 'B', 'A'>>;
+
+  static_assert(Algae::length(10) == 144, "algae grows as the fibonacci numbers.");
+  static_assert(Algae::successorLength('A') == 2, "A rewrites to two symbols.");
+
+  auto lstring = Algae::generate(generation);
+
+  assert(represent(lstring) == represent(Algae::toSystem().generate(generation)) && "a static system must generate what the same LSystem does.");
+
+  std::cout << "Generation " << generation << " (" << lstring.size() << " symbols): " << represent(lstring) << '\n';
+
+  return 0;
+}
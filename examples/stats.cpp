@@ -0,0 +1,50 @@
+//Demonstration of generation statistics, showing which rule drives the growth of a plant and warning when a generation grows too fast
+//Usage: stats generation
+
+#include <iostream>
+#include <cassert>
+#include <stdlib.h>
+
+#include "l_system/l_system.h"
+
+int main(int argc, char const *argv[]) {
+
+  using namespace l_system;
+
+  assert(argc >= 2 && "Usage: stats generation");
+  int generation = static_cast<int>(strtol(argv[1], nullptr, 0));
+
+  LSymbolType f('F');
+  LSymbolType x('X');
+  LSymbolType left('+');
+  LSymbolType right('-');
+  LSymbolType push('[');
+  LSymbolType pop(']');
+
+  LSystem<char> plant({LSymbol(x)});
+
+  plant.addRule(LRule<char>(x, {f, left, push, push, x, pop, right, x, pop, right, f, push, right, f, x, pop, left, x}));
+  plant.addRule(LRule<char>(f, {f, f}));
+
+  //the callback sees every generation as it is rewritten, a good place for an alert
+  plant.setGenerationCallback([](const LGenerationStats& stats) {
+
+    if(stats.growth() > 2.5) {
+
+      std::cout << "Generation " << stats.generation << " grew " << stats.growth() << " times\n";
+    }
+  });
+
+  plant.enableStats();
+  plant.generate(generation);
+
+  std::cout << "generation,seconds,input,output,kept,X_hits,X_output,F_hits,F_output\n";
+
+  for(const auto& stats : plant.stats()) {
+
+    std::cout << stats.generation << ',' << stats.seconds << ',' << stats.inputSymbols << ',' << stats.outputSymbols << ',' << stats.kept << ','
+      << stats.ruleHits[0] << ',' << stats.ruleOutput[0] << ',' << stats.ruleHits[1] << ',' << stats.ruleOutput[1] << '\n';
+  }
+
+  return 0;
+}
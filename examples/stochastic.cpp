@@ -0,0 +1,47 @@
+//Demonstration of stochastic rules, replaying seeded variants of a plant
+//Every seed gives a different plant, and the same seed always gives the same one, whatever the number of threads
+
+#include <iostream>
+#include <cassert>
+#include <stdlib.h>
+
+#include "l_system/l_system.h"
+
+int main(int argc, char const *argv[]) {
+
+  using namespace l_system;
+
+  assert(argc >= 3 && "Usage: stochastic generation variants");
+  int generation = static_cast<int>(strtol(argv[1], nullptr, 0));
+  auto variants = strtoull(argv[2], nullptr, 0);
+
+  LSymbolType f('F'); //draws forward
+  LSymbolType left('+'); //turns
+  LSymbolType right('-');
+  LSymbolType push('['); //branches
+  LSymbolType pop(']');
+
+  LSystem<char> plant({LSymbol(f)});
+
+  //each F is rewritten into one of three shapes, the weights need not sum to 1
+  plant.addRule(LRule<char>(f, LAlternatives<char>{
+    {1.0, {f, push, left, f, pop, f, push, right, f, pop, f}},
+    {1.0, {f, push, left, f, pop, f}},
+    {2.0, {f, push, right, f, pop, f}}
+  }));
+
+  std::cout << "Rule: " << plant.rules().front().representation() << '\n';
+
+  for(unsigned long long seed = 0; seed < variants; ++seed) {
+
+    plant.setSeed(seed);
+
+    auto lstring = plant.generate(generation);
+
+    assert(represent(lstring) == represent(plant.generate(generation, 4)) && "stochastic generation must not depend on threads.");
+
+    std::cout << "Seed " << seed << " (" << lstring.size() << " symbols): " << represent(lstring) << '\n';
+  }
+
+  return 0;
+}
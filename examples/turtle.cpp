@@ -0,0 +1,78 @@
+//Demonstration of turtle interpretation, drawing a bracketed plant into line segments
+//The segments can be drawn from a generated string, or straight from the system's stream without ever holding the string
+
+#include <iostream>
+#include <cassert>
+#include <stdlib.h>
+
+#include "l_system/l_system.h"
+#include "l_system/l_turtle.h"
+
+int main(int argc, char const *argv[]) {
+
+  using namespace l_system;
+
+  assert(argc >= 2 && "Usage: turtle generation");
+  int generation = static_cast<int>(strtol(argv[1], nullptr, 0));
+
+  LSymbolType x('X'); //only steers growth, not drawn
+  LSymbolType f('F'); //draws forward
+  LSymbolType left('+'); //turns
+  LSymbolType right('-');
+  LSymbolType push('['); //branches
+  LSymbolType pop(']');
+  LSymbolType thin('!', parameterSet(0, 0, 1)); //sets the width to its float parameter
+
+  LSystem<char> plant({LSymbol(x)});
+
+  plant.addRule(LRule(x, {f, left, push, push, x, pop, right, x, pop, right, f, push, right, f, x, pop, left, x}));
+  plant.addRule(LRule(f, {f, f}));
+
+  LTurtle<char> turtle;
+
+  turtle.setAction(f, LTURTLE_FORWARD, 1.0f); //F moves 1 forward while drawing
+  turtle.setAction(left, LTURTLE_TURN, 25.0f); //+ turns 25 degrees counterclockwise
+  turtle.setAction(right, LTURTLE_TURN, -25.0f);
+  turtle.setAction(push, LTURTLE_PUSH);
+  turtle.setAction(pop, LTURTLE_POP);
+  turtle.setAction(thin, LTURTLE_WIDTH);
+
+  LSegments segments;
+
+  const auto stream = plant.stream(generation);
+  assert(stream && "the plant's rules rewrite every symbol of a type alike.");
+
+  turtle.interpret(*stream, segments); //fused with generation, the string is never materialized
+
+  std::cout << "Segments: " << segments.size() << '\n';
+
+  float top = 0.0f;
+
+  for(size_t i = 0; i < segments.size(); ++i) {
+
+    top = std::max(top, segments.y1[i]);
+  }
+
+  std::cout << "Height: " << top << '\n';
+
+  for(size_t i = 0; i < segments.size() && i < 5; ++i) {
+
+    std::cout << '(' << segments.x0[i] << ", " << segments.y0[i] << ") -> (" << segments.x1[i] << ", " << segments.y1[i] << ")\n";
+  }
+
+  //symbols with a float parameter use it as their argument
+  LSymbol<char> narrow(thin);
+  narrow.setFloatParam(0.25f, 0);
+
+  LSegments stem;
+
+  turtle.reset();
+  turtle.interpret(LString<char>({LSymbol(f), narrow, LSymbol(right), LSymbol(f)}), stem);
+
+  for(size_t i = 0; i < stem.size(); ++i) {
+
+    std::cout << '(' << stem.x0[i] << ", " << stem.y0[i] << ") -> (" << stem.x1[i] << ", " << stem.y1[i] << ") width " << stem.width[i] << '\n';
+  }
+
+  return 0;
+}
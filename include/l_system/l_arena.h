@@ -0,0 +1,243 @@
+#ifndef L_SYSTEM_ARENA_H
+#define L_SYSTEM_ARENA_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace l_system {
+
+  //a monotonic memory resource which threads can allocate from at once
+  //each thread bumps through blocks of its own, so threads never wait on each other or on malloc for small allocations
+  //deallocation does nothing, rewind frees every allocation at once while keeping the blocks, and release hands the blocks back
+  class LArena : public std::pmr::memory_resource {
+
+    struct Block {
+
+      unsigned char* data;
+      size_t size;
+      bool dedicated; //made for one request larger than a regular block
+    };
+
+    //one thread's blocks, the first touched of them handed out from since the last rewind and the rest kept for later
+    struct Blocks {
+
+      std::thread::id thread;
+      std::vector<Block> blocks;
+      size_t touched = 0;
+      size_t used = 0; //bytes of the last touched block already handed out
+      size_t nextSize = 0; //the size of the next regular block, doubling with each
+    };
+
+    struct Cache {
+
+      std::uint64_t arena = 0; //the identity of the arena the blocks belong to
+      Blocks* blocks = nullptr;
+    };
+
+    //the arenas a thread allocated from last, a generation alternates between two of them
+    constexpr const static size_t CACHED = 4;
+
+    std::mutex mutex_; //guards threads_
+    std::vector<std::unique_ptr<Blocks>> threads_;
+    std::pmr::memory_resource* upstream_;
+    size_t blockSize_;
+    std::uint64_t identity_; //unique to this arena, so that no thread uses the blocks of a destroyed one found at the same address
+
+    static auto nextIdentity() noexcept -> std::uint64_t {
+
+      static std::atomic<std::uint64_t> identities(1);
+
+      return identities.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static auto cache() noexcept -> std::array<Cache, CACHED>& {
+
+      thread_local std::array<Cache, CACHED> cache;
+
+      return cache;
+    }
+
+    //the entry of cache replaced next, entries are replaced in turn
+    static auto replacement() noexcept -> size_t& {
+
+      thread_local size_t replaced = 0;
+
+      return replaced;
+    }
+
+    //the calling thread's blocks, found without locking after a thread's first allocation
+    auto local() -> Blocks& {
+
+      auto& cached = cache();
+
+      for(const auto& entry : cached) {
+
+        if(entry.arena == identity_) {
+
+          return *entry.blocks;
+        }
+      }
+
+      const std::lock_guard<std::mutex> lock(mutex_);
+      const auto id = std::this_thread::get_id();
+
+      auto found = std::find_if(threads_.begin(), threads_.end(), [&](const auto& thread) { return thread->thread == id; });
+
+      if(found == threads_.end()) {
+
+        threads_.emplace_back(std::make_unique<Blocks>());
+        threads_.back()->thread = id;
+        threads_.back()->nextSize = blockSize_;
+        found = threads_.end() - 1;
+      }
+
+      auto& replaced = replacement();
+
+      cached[replaced] = {identity_, found->get()};
+      replaced = (replaced + 1) % CACHED;
+
+      return **found;
+    }
+
+    //the offset from which bytes aligned to alignment fit in block after used bytes, or past its end if they do not
+    static auto fit(const Block& block, size_t used, size_t bytes, size_t alignment) noexcept -> size_t {
+
+      const auto address = reinterpret_cast<std::uintptr_t>(block.data) + used;
+      const auto offset = used + (alignment - address % alignment) % alignment;
+
+      return (offset <= block.size && bytes <= block.size - offset) ? offset : block.size + 1;
+    }
+
+    //starts handing out from blocks[index], which must be untouched, making it the last touched block
+    static void touch(Blocks& local, size_t index) noexcept {
+
+      std::swap(local.blocks[index], local.blocks[local.touched]);
+      ++local.touched;
+      local.used = 0;
+    }
+
+    auto allocateFrom(Blocks& local, size_t bytes, size_t alignment) -> void* {
+
+      if(local.touched > 0) {
+
+        const auto& block = local.blocks[local.touched - 1];
+        const auto offset = fit(block, local.used, bytes, alignment);
+
+        if(offset <= block.size) {
+
+          local.used = offset + bytes;
+
+          return block.data + offset;
+        }
+      }
+
+      const auto large = bytes + alignment > local.nextSize;
+
+      for(size_t i = local.touched; i < local.blocks.size();) {
+
+        const auto& block = local.blocks[i];
+
+        if(fit(block, 0, bytes, alignment) <= block.size) {
+
+          touch(local, i);
+
+          return allocateFrom(local, bytes, alignment);
+        }
+
+        //a block made for a smaller large request is outgrown, as requests such as a string's growing buffer only get larger
+        if(large && block.dedicated) {
+
+          upstream_->deallocate(block.data, block.size, alignof(std::max_align_t));
+          local.blocks.erase(local.blocks.begin() + static_cast<std::ptrdiff_t>(i));
+          continue;
+        }
+
+        ++i;
+      }
+
+      const auto size = large ? bytes + alignment : local.nextSize;
+
+      if(!large) {
+
+        local.nextSize *= 2;
+      }
+
+      local.blocks.push_back({static_cast<unsigned char*>(upstream_->allocate(size, alignof(std::max_align_t))), size, large});
+      touch(local, local.blocks.size() - 1);
+
+      return allocateFrom(local, bytes, alignment);
+    }
+
+  protected:
+
+    auto do_allocate(size_t bytes, size_t alignment) -> void* override {
+
+      return allocateFrom(local(), bytes, alignment);
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override {
+
+      return this == &other;
+    }
+
+  public:
+
+    //blockSize is the size of each thread's first block, later blocks grow geometrically
+    LArena(size_t blockSize = 1 << 16, std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) :
+      upstream_(upstream),
+      blockSize_(blockSize),
+      identity_(nextIdentity()) {}
+
+    LArena(const LArena&) = delete;
+    auto operator=(const LArena&) -> LArena& = delete;
+
+    ~LArena() override {
+
+      release();
+    }
+
+    //frees everything allocated from the arena, which must no longer be in use by any thread, keeping the blocks to bump through again
+    void rewind() noexcept {
+
+      const std::lock_guard<std::mutex> lock(mutex_);
+
+      for(auto& thread : threads_) {
+
+        thread->touched = 0;
+        thread->used = 0;
+      }
+    }
+
+    //frees everything allocated from the arena, which must no longer be in use by any thread, handing the blocks back upstream
+    void release() noexcept {
+
+      const std::lock_guard<std::mutex> lock(mutex_);
+
+      for(auto& thread : threads_) {
+
+        for(const auto& block : thread->blocks) {
+
+          upstream_->deallocate(block.data, block.size, alignof(std::max_align_t));
+        }
+
+        thread->blocks.clear();
+        thread->touched = 0;
+        thread->used = 0;
+        thread->nextSize = blockSize_;
+      }
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef L_SYSTEM_BATCH_H
+#define L_SYSTEM_BATCH_H
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "l_system/l_system.h"
+
+namespace l_system {
+
+  //one system to generate to a number of generations
+  template <typename T, typename Hash = std::hash<T>>
+  struct LBatchJob {
+
+    const LSystem<T, Hash>* system;
+    int generations;
+  };
+
+  //the jobs one worker still has to run, [begin, end) of the batch
+  //the owner takes jobs from the front while idle workers steal half of what is left from the back
+  class LWorkQueue {
+
+    std::mutex mutex_;
+    size_t begin_ = 0;
+    size_t end_ = 0;
+
+  public:
+
+    void assign(size_t begin, size_t end) noexcept {
+
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      begin_ = begin;
+      end_ = end;
+    }
+
+    auto take(size_t& job) noexcept -> bool {
+
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      if(begin_ == end_) {
+
+        return false;
+      }
+
+      job = begin_++;
+
+      return true;
+    }
+
+    //moves the back half of the jobs left into range, false if none are left
+    auto steal(std::pair<size_t, size_t>& range) noexcept -> bool {
+
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      if(begin_ == end_) {
+
+        return false;
+      }
+
+      const auto middle = end_ - (end_ - begin_ + 1) / 2;
+
+      range = {middle, end_};
+      end_ = middle;
+
+      return true;
+    }
+  };
+
+  //runs many independent generations at once, each on a single thread, spread over a fixed number of workers
+  //workers start with near-equal contiguous runs of jobs and steal from each other once theirs are done, so uneven jobs still keep every worker busy
+  //each worker rewrites through buffers of its own, which keep their capacity from one job to the next
+  //systems may appear in several jobs, but none may change while a batch runs, and none gathers statistics or calls its generation callback for them
+  class LSystemBatch {
+
+    unsigned threads_;
+
+  public:
+
+    LSystemBatch(unsigned threads = std::thread::hardware_concurrency()) noexcept : threads_(std::max(1u, threads)) {}
+
+    auto threads() const noexcept -> unsigned {
+
+      return threads_;
+    }
+
+    //runs job(worker, n) for each n in [0, count), where worker in [0, threads) identifies the calling worker's scratch
+    template <typename F>
+    void schedule(size_t count, F&& job) const {
+
+      const auto workers = static_cast<unsigned>(std::min<size_t>(threads_, count));
+
+      if(workers == 0) {
+
+        return;
+      }
+
+      std::vector<LWorkQueue> queues(workers);
+
+      for(size_t w = 0; w < workers; ++w) {
+
+        queues[w].assign(chunkBegin(count, workers, w), chunkBegin(count, workers, w + 1));
+      }
+
+      parallelFor(workers, [&](size_t w) {
+
+        for(;;) {
+
+          size_t n = 0;
+
+          while(queues[w].take(n)) {
+
+            job(w, n);
+          }
+
+          //only the owner refills its own queue, so an empty queue stays empty until then
+          std::pair<size_t, size_t> stolen;
+          bool found = false;
+
+          for(size_t v = 1; v < workers && !found; ++v) {
+
+            found = queues[(w + v) % workers].steal(stolen);
+          }
+
+          if(!found) {
+
+            return;
+          }
+
+          queues[w].assign(stolen.first, stolen.second);
+        }
+      });
+    }
+
+    //generates every job, handing sink(n, lstring) the result of job n on the worker that generated it
+    //sink is called from several threads at once and lstring is reused once sink returns
+    template <typename T, typename Hash, typename Sink>
+    void run(const std::vector<LBatchJob<T, Hash>>& jobs, Sink&& sink) const {
+
+      std::vector<std::pair<LString<T>, LString<T>>> scratch(std::min<size_t>(threads_, jobs.size()));
+
+      schedule(jobs.size(), [&](size_t worker, size_t n) {
+
+        auto& [result, buffer] = scratch[worker];
+
+        jobs[n].system->generateInto(jobs[n].generations, result, buffer);
+        sink(n, std::as_const(result));
+      });
+    }
+
+    //generates every job, result n is that of job n
+    template <typename T, typename Hash>
+    auto run(const std::vector<LBatchJob<T, Hash>>& jobs) const -> std::vector<LString<T>> {
+
+      std::vector<LString<T>> results(jobs.size());
+      std::vector<LString<T>> scratch(std::min<size_t>(threads_, jobs.size()));
+
+      schedule(jobs.size(), [&](size_t worker, size_t n) {
+
+        jobs[n].system->generateInto(jobs[n].generations, results[n], scratch[worker]);
+      });
+
+      return results;
+    }
+
+    //generates every system to the same number of generations
+    template <typename T, typename Hash>
+    auto run(const std::vector<LSystem<T, Hash>>& systems, int generations) const -> std::vector<LString<T>> {
+
+      return run(jobs(systems, generations));
+    }
+
+    template <typename T, typename Hash, typename Sink>
+    void run(const std::vector<LSystem<T, Hash>>& systems, int generations, Sink&& sink) const {
+
+      run(jobs(systems, generations), std::forward<Sink>(sink));
+    }
+
+    template <typename T, typename Hash>
+    static auto jobs(const std::vector<LSystem<T, Hash>>& systems, int generations) -> std::vector<LBatchJob<T, Hash>> {
+
+      std::vector<LBatchJob<T, Hash>> result;
+      result.reserve(systems.size());
+
+      for(const auto& system : systems) {
+
+        result.push_back({&system, generations});
+      }
+
+      return result;
+    }
+  };
+}
+
+#endif
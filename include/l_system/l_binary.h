@@ -0,0 +1,756 @@
+#ifndef L_SYSTEM_BINARY_H
+#define L_SYSTEM_BINARY_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define L_SYSTEM_MMAP 1
+#endif
+
+#include "l_system/l_compact.h"
+#include "l_system/l_rule.h"
+
+namespace l_system {
+
+  //bumped whenever the layout changes, files of another version are refused
+  constexpr const static std::uint32_t LBINARY_VERSION = 1;
+
+  //written as a number and read back, it only reads the same on machines of the same byte order
+  constexpr const static std::uint32_t LBINARY_BYTE_ORDER = 0x01020304;
+
+  //every section starts at a multiple of this from the start of the file, so that mapped arrays are aligned
+  constexpr const static size_t LBINARY_ALIGNMENT = 8;
+
+  //the start of a stored string, followed by its types, its ids, its offsets if it has parameters, and its arena
+  //a type is its parameter set and custom size as two uint32, then the raw bytes of its representation
+  struct LBinaryStringHeader {
+
+    char magic[4]; //"LSTR"
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint32_t representationSize; //sizeof(T) of the writer
+    std::uint64_t typeCount;
+    std::uint64_t symbolCount;
+    std::uint64_t arenaSize;
+    std::uint64_t hasOffsets; //1 if symbolCount uint64 arena offsets follow the ids
+  };
+
+  //writes values in native byte order, padding sections to LBINARY_ALIGNMENT
+  class LBinaryWriter {
+
+    std::ostream& out_;
+    size_t written_ = 0;
+
+  public:
+
+    LBinaryWriter(std::ostream& out) : out_(out) {}
+
+    void bytes(const void* data, size_t size) {
+
+      out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+      written_ += size;
+    }
+
+    template <typename U>
+    void value(const U& u) {
+
+      static_assert(std::is_trivially_copyable_v<U>, "only trivially copyable values can be written.");
+
+      bytes(&u, sizeof(u));
+    }
+
+    void pad() {
+
+      constexpr const char zeros[LBINARY_ALIGNMENT] = {};
+
+      bytes(zeros, (LBINARY_ALIGNMENT - written_ % LBINARY_ALIGNMENT) % LBINARY_ALIGNMENT);
+    }
+
+    auto good() const -> bool {
+
+      return out_.good();
+    }
+  };
+
+  //reads values in place from bytes in memory, once a read runs past the end every later read fails
+  class LBinaryReader {
+
+    const unsigned char* data_;
+    size_t size_;
+    size_t position_ = 0;
+    bool failed_ = false;
+
+  public:
+
+    LBinaryReader(const unsigned char* data, size_t size) : data_(data), size_(size) {}
+
+    //the address of the next size bytes, or nullptr if fewer remain
+    auto bytes(size_t size) noexcept -> const unsigned char* {
+
+      if(failed_ || size > size_ - position_) {
+
+        failed_ = true;
+        return nullptr;
+      }
+
+      const auto* result = data_ + position_;
+      position_ += size;
+
+      return result;
+    }
+
+    template <typename U>
+    auto value() noexcept -> U {
+
+      U u{};
+      const auto* data = bytes(sizeof(U));
+
+      if(data != nullptr) {
+
+        memcpy(&u, data, sizeof(U));
+      }
+
+      return u;
+    }
+
+    void pad() noexcept {
+
+      bytes((LBINARY_ALIGNMENT - position_ % LBINARY_ALIGNMENT) % LBINARY_ALIGNMENT);
+    }
+
+    auto failed() const noexcept -> bool {
+
+      return failed_;
+    }
+  };
+
+  template <typename T>
+  void writeType(LBinaryWriter& writer, const LSymbolType<T>& type) {
+
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable representations can be stored.");
+
+    const T representation = type.representation();
+
+    writer.value(static_cast<std::uint32_t>(type.paramSet()));
+    writer.value(static_cast<std::uint32_t>(type.customParamSize()));
+    writer.bytes(&representation, sizeof(T));
+    writer.pad();
+  }
+
+  template <typename T>
+  auto readType(LBinaryReader& reader) -> std::optional<LSymbolType<T>> {
+
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable representations can be stored.");
+
+    const auto set = reader.value<std::uint32_t>();
+    const auto customSize = reader.value<std::uint32_t>();
+    const auto* bytes = reader.bytes(sizeof(T));
+
+    reader.pad();
+
+    if(reader.failed()) {
+
+      return std::nullopt;
+    }
+
+    //copied rather than read in place, as the bytes need not be aligned for a T
+    alignas(T) unsigned char storage[sizeof(T)];
+    memcpy(storage, bytes, sizeof(T));
+
+    return LSymbolType<T>(*std::launder(reinterpret_cast<const T*>(storage)), set, static_cast<LParameterCustomSize>(customSize));
+  }
+
+  template <typename T>
+  void writeTypes(LBinaryWriter& writer, const LTypeString<T>& types) {
+
+    writer.value<std::uint64_t>(types.size());
+
+    for(const auto& type : types) {
+
+      writeType(writer, type);
+    }
+  }
+
+  template <typename T>
+  auto readTypes(LBinaryReader& reader) -> std::optional<LTypeString<T>> {
+
+    const auto count = reader.value<std::uint64_t>();
+    LTypeString<T> types;
+
+    for(std::uint64_t i = 0; i < count && !reader.failed(); ++i) {
+
+      auto type = readType<T>(reader);
+
+      if(!type) {
+
+        return std::nullopt;
+      }
+
+      types.emplace_back(*type);
+    }
+
+    return reader.failed() ? std::nullopt : std::optional<LTypeString<T>>(std::move(types));
+  }
+
+  //an expression's postfix code, each instruction stored as its operation, constant and operand
+  inline void writeCode(LBinaryWriter& writer, const std::vector<LInstruction>& code) {
+
+    writer.value<std::uint64_t>(code.size());
+
+    for(const auto& instruction : code) {
+
+      writer.value(static_cast<std::uint32_t>(instruction.operation));
+      writer.value(instruction.constant);
+      writer.value<std::uint64_t>(instruction.operand);
+    }
+  }
+
+  //reads code as compile expects it, loading only parameters of set and leaving exactly one value on the stack, or nothing
+  inline auto readCode(LBinaryReader& reader, LParameterSet set) -> std::optional<std::vector<LInstruction>> {
+
+    const auto count = reader.value<std::uint64_t>();
+    std::vector<LInstruction> code;
+    std::uint64_t top = 0;
+
+    for(std::uint64_t i = 0; i < count && !reader.failed(); ++i) {
+
+      const auto operation = reader.value<std::uint32_t>();
+      const auto constant = reader.value<float>();
+      const auto operand = reader.value<std::uint64_t>();
+
+      if(operation > LOP_OR) {
+
+        return std::nullopt;
+      }
+
+      const auto loaded = (operation == LOP_CHAR) ? LCHAR : (operation == LOP_INT) ? LINT : LFLOAT;
+
+      if(operation >= LOP_CHAR && operation <= LOP_FLOAT && operand >= parameterCount(set, loaded)) {
+
+        return std::nullopt;
+      }
+
+      //loads push a value, unary operations need one and binary operations pop one of two
+      if(operation <= LOP_FLOAT) {
+
+        ++top;
+      }
+      else if(top < ((operation >= LOP_ADD) ? 2u : 1u)) {
+
+        return std::nullopt;
+      }
+      else if(operation >= LOP_ADD) {
+
+        --top;
+      }
+
+      code.push_back({static_cast<LOperation>(operation), static_cast<LParameterDataSize>(operand), constant});
+    }
+
+    return (reader.failed() || top != 1) ? std::nullopt : std::optional<std::vector<LInstruction>>(std::move(code));
+  }
+
+  //a rule as its predecessor, contexts, weighted alternatives with their parameter expressions, and guard
+  template <typename T>
+  void writeRule(LBinaryWriter& writer, const LRule<T>& rule) {
+
+    writeType(writer, rule.predecessor());
+    writeTypes(writer, rule.left());
+    writeTypes(writer, rule.right());
+    writer.value<std::uint64_t>(rule.alternatives().size());
+
+    for(size_t alternative = 0; alternative < rule.alternatives().size(); ++alternative) {
+
+      writer.value(rule.alternatives()[alternative].weight);
+      writeTypes(writer, rule.alternatives()[alternative].result);
+      writer.value<std::uint64_t>(rule.expressions(alternative).size());
+
+      for(const auto& expression : rule.expressions(alternative)) {
+
+        writer.value<std::uint64_t>(expression.symbol);
+        writer.value(static_cast<std::uint32_t>(expression.kind));
+        writer.value(static_cast<std::uint32_t>(expression.n));
+        writeCode(writer, expression.expression.code());
+      }
+    }
+
+    writer.value(static_cast<std::uint64_t>(rule.guard() ? 1 : 0));
+
+    if(rule.guard()) {
+
+      writeCode(writer, rule.guard()->code());
+    }
+  }
+
+  template <typename T>
+  auto readRule(LBinaryReader& reader) -> std::optional<LRule<T>> {
+
+    const auto predecessor = readType<T>(reader);
+    const auto left = readTypes<T>(reader);
+    const auto right = readTypes<T>(reader);
+    const auto alternativeCount = reader.value<std::uint64_t>();
+
+    if(!predecessor || !left || !right || alternativeCount == 0) {
+
+      return std::nullopt;
+    }
+
+    LAlternatives<T> alternatives;
+    std::vector<std::vector<LParameterExpression>> expressions;
+    double total = 0;
+
+    for(std::uint64_t alternative = 0; alternative < alternativeCount && !reader.failed(); ++alternative) {
+
+      const auto weight = reader.value<double>();
+      auto result = readTypes<T>(reader);
+      const auto expressionCount = reader.value<std::uint64_t>();
+
+      //weights are turned into an alias table, which needs them finite, not negative and not all 0
+      if(!result || !std::isfinite(weight) || weight < 0) {
+
+        return std::nullopt;
+      }
+
+      total += weight;
+
+      alternatives.push_back({weight, *result});
+      expressions.emplace_back();
+
+      for(std::uint64_t i = 0; i < expressionCount && !reader.failed(); ++i) {
+
+        const auto symbol = reader.value<std::uint64_t>();
+        const auto kind = reader.value<std::uint32_t>();
+        const auto n = reader.value<std::uint32_t>();
+        auto code = readCode(reader, predecessor->paramSet());
+
+        if(!code || symbol >= result->size() || n > MAX_PARAMS || n >= parameterCount((*result)[symbol].paramSet(), static_cast<LParameter>(kind))) {
+
+          return std::nullopt;
+        }
+
+        expressions.back().push_back({static_cast<size_t>(symbol), static_cast<LParameter>(kind), static_cast<LParameterCount>(n), LExpression(std::move(*code))});
+      }
+    }
+
+    const auto hasGuard = reader.value<std::uint64_t>();
+    const auto guard = (hasGuard != 0) ? readCode(reader, predecessor->paramSet()) : std::nullopt;
+
+    if(reader.failed() || (hasGuard != 0 && !guard) || !std::isfinite(total) || total <= 0) {
+
+      return std::nullopt;
+    }
+
+    LRule<T> rule(*left, *predecessor, *right, alternatives);
+
+    for(size_t alternative = 0; alternative < expressions.size(); ++alternative) {
+
+      for(const auto& expression : expressions[alternative]) {
+
+        rule.setParameter(expression.symbol, expression.kind, expression.n, expression.expression, alternative);
+      }
+    }
+
+    if(guard) {
+
+      rule.setGuard(LExpression(*guard));
+    }
+
+    return rule;
+  }
+
+  template <typename T, typename Hash>
+  void writeStringHeader(LBinaryWriter& writer, const LSymbolRegistry<T, Hash>& registry, size_t symbols, size_t arenaSize, bool hasOffsets) {
+
+    LBinaryStringHeader header = {{'L', 'S', 'T', 'R'}, LBINARY_VERSION, LBINARY_BYTE_ORDER, sizeof(T), registry.size(), symbols, arenaSize, hasOffsets ? 1U : 0U};
+
+    writer.value(header);
+
+    for(LSymbolId id = 0; id < registry.size(); ++id) {
+
+      writeType(writer, registry.type(id));
+    }
+  }
+
+  template <typename T, typename Hash>
+  void writeString(LBinaryWriter& writer, const LCompactString<T, Hash>& lstring) {
+
+    const auto& offsets = lstring.offsets();
+
+    writeStringHeader(writer, lstring.registry(), lstring.size(), lstring.arena().size(), !offsets.empty());
+
+    writer.bytes(lstring.ids().data(), lstring.size() * sizeof(LSymbolId));
+    writer.pad();
+
+    if constexpr (sizeof(size_t) == sizeof(std::uint64_t)) {
+
+      writer.bytes(offsets.data(), offsets.size() * sizeof(std::uint64_t));
+    }
+    else {
+
+      for(auto offset : offsets) {
+
+        writer.value<std::uint64_t>(offset);
+      }
+    }
+
+    writer.bytes(lstring.arena().data(), lstring.arena().size());
+    writer.pad();
+  }
+
+  //writes an LString in the same layout as its compact form, without building the compact form in memory
+  template <typename T, typename Hash = std::hash<T>>
+  void writeString(LBinaryWriter& writer, const LString<T>& lstring) {
+
+    constexpr const size_t chunk = 4096;
+
+    LSymbolRegistry<T, Hash> registry;
+    size_t arenaSize = 0;
+
+    for(const auto& symbol : lstring) {
+
+      registry.intern(symbol.type());
+      arenaSize += symbol.parameters().size();
+    }
+
+    writeStringHeader(writer, registry, lstring.size(), arenaSize, arenaSize > 0);
+
+    std::vector<LSymbolId> ids;
+    ids.reserve(chunk);
+
+    for(size_t begin = 0; begin < lstring.size(); begin += chunk) {
+
+      ids.clear();
+
+      for(size_t i = begin; i < lstring.size() && i < begin + chunk; ++i) {
+
+        ids.emplace_back(registry.find(lstring[i].type().representation()));
+      }
+
+      writer.bytes(ids.data(), ids.size() * sizeof(LSymbolId));
+    }
+
+    writer.pad();
+
+    if(arenaSize > 0) {
+
+      std::vector<std::uint64_t> offsets;
+      std::uint64_t offset = 0;
+
+      offsets.reserve(chunk);
+
+      for(size_t begin = 0; begin < lstring.size(); begin += chunk) {
+
+        offsets.clear();
+
+        for(size_t i = begin; i < lstring.size() && i < begin + chunk; ++i) {
+
+          offsets.emplace_back(offset);
+          offset += lstring[i].parameters().size();
+        }
+
+        writer.bytes(offsets.data(), offsets.size() * sizeof(std::uint64_t));
+      }
+
+      for(const auto& symbol : lstring) {
+
+        writer.bytes(symbol.parameters().data(), symbol.parameters().size());
+      }
+    }
+
+    writer.pad();
+  }
+
+  //a read only file held in memory, mapped where the platform allows it and read in otherwise
+  class LMappedFile {
+
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<unsigned char> buffer_; //the file's contents when it is not mapped
+    bool mapped_ = false;
+
+  public:
+
+    LMappedFile() = default;
+    LMappedFile(const LMappedFile&) = delete;
+    auto operator=(const LMappedFile&) -> LMappedFile& = delete;
+
+    ~LMappedFile() {
+
+#ifdef L_SYSTEM_MMAP
+      if(mapped_) {
+
+        munmap(const_cast<unsigned char*>(data_), size_);
+      }
+#endif
+    }
+
+    //the file at path, or nullptr if it can not be read
+    static auto open(const std::string& path) -> std::shared_ptr<const LMappedFile> {
+
+      auto file = std::make_shared<LMappedFile>();
+
+#ifdef L_SYSTEM_MMAP
+      const int descriptor = ::open(path.c_str(), O_RDONLY);
+
+      if(descriptor < 0) {
+
+        return nullptr;
+      }
+
+      struct stat status;
+
+      if(fstat(descriptor, &status) != 0) {
+
+        close(descriptor);
+        return nullptr;
+      }
+
+      file->size_ = static_cast<size_t>(status.st_size);
+
+      if(file->size_ > 0) {
+
+        void* address = mmap(nullptr, file->size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+        if(address == MAP_FAILED) {
+
+          close(descriptor);
+          return nullptr;
+        }
+
+        file->data_ = static_cast<const unsigned char*>(address);
+        file->mapped_ = true;
+      }
+
+      close(descriptor);
+#else
+      std::ifstream in(path, std::ios::binary);
+
+      if(!in) {
+
+        return nullptr;
+      }
+
+      file->buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+      file->data_ = file->buffer_.data();
+      file->size_ = file->buffer_.size();
+#endif
+
+      return file;
+    }
+
+    auto data() const noexcept -> const unsigned char* {
+
+      return data_;
+    }
+
+    auto size() const noexcept -> size_t {
+
+      return size_;
+    }
+  };
+
+  //a read only view of a stored string, whose ids, offsets and arena are used in place rather than copied
+  //only the type table is copied out, the view keeps whatever holds the bytes alive
+  //the header, sizes, ids and offsets are all checked when parsing, so indexing a view of a damaged file never reads outside of its bytes
+  template <typename T, typename Hash = std::hash<T>>
+  class LMappedString {
+
+    std::shared_ptr<const void> owner_; //keeps the viewed bytes alive
+    LSymbolRegistry<T, Hash> registry_;
+    const LSymbolId* ids_ = nullptr;
+    const std::uint64_t* offsets_ = nullptr; //nullptr if no symbol has parameters
+    const unsigned char* arena_ = nullptr;
+    size_t size_ = 0;
+    size_t arenaSize_ = 0;
+
+  public:
+
+    //reads a stored string from a reader over bytes which owner keeps alive, or nothing if they do not hold a valid one
+    static auto parse(LBinaryReader& reader, std::shared_ptr<const void> owner) -> std::optional<LMappedString> {
+
+      const auto header = reader.value<LBinaryStringHeader>();
+
+      if(reader.failed() || memcmp(header.magic, "LSTR", 4) != 0 || header.version != LBINARY_VERSION || header.byteOrder != LBINARY_BYTE_ORDER || header.representationSize != sizeof(T)) {
+
+        return std::nullopt;
+      }
+
+      //the sections' sizes are computed from these, and must not wrap
+      if(header.symbolCount > std::numeric_limits<size_t>::max() / sizeof(std::uint64_t) || header.arenaSize > std::numeric_limits<size_t>::max()) {
+
+        return std::nullopt;
+      }
+
+      LMappedString result;
+      result.owner_ = std::move(owner);
+      result.size_ = header.symbolCount;
+      result.arenaSize_ = header.arenaSize;
+
+      for(std::uint64_t id = 0; id < header.typeCount; ++id) {
+
+        auto type = readType<T>(reader);
+
+        if(!type || result.registry_.intern(*type) != id) {
+
+          return std::nullopt;
+        }
+      }
+
+      const auto* ids = reader.bytes(result.size_ * sizeof(LSymbolId));
+      reader.pad();
+      const auto* offsets = (header.hasOffsets != 0) ? reader.bytes(result.size_ * sizeof(std::uint64_t)) : nullptr;
+      const auto* arena = reader.bytes(result.arenaSize_);
+      reader.pad();
+
+      //sections are aligned relative to the start of the bytes, which must be aligned themselves for the arrays to be used in place
+      if(reader.failed() || reinterpret_cast<std::uintptr_t>(ids) % alignof(LSymbolId) != 0 || reinterpret_cast<std::uintptr_t>(offsets) % alignof(std::uint64_t) != 0) {
+
+        return std::nullopt;
+      }
+
+      result.ids_ = reinterpret_cast<const LSymbolId*>(ids);
+      result.offsets_ = reinterpret_cast<const std::uint64_t*>(offsets);
+      result.arena_ = arena;
+
+      std::vector<size_t> parameterSizes;
+
+      for(LSymbolId id = 0; id < result.registry_.size(); ++id) {
+
+        const auto& type = result.registry_.type(id);
+
+        parameterSizes.emplace_back(requiredDataSize(type.paramSet(), type.customParamSize()));
+      }
+
+      //every symbol must be of a stored type, and its parameters within the arena
+      for(size_t i = 0; i < result.size_; ++i) {
+
+        const auto id = result.ids_[i];
+        const auto offset = (result.offsets_ == nullptr) ? 0 : result.offsets_[i];
+
+        if(id >= parameterSizes.size() || offset > result.arenaSize_ || parameterSizes[id] > result.arenaSize_ - offset) {
+
+          return std::nullopt;
+        }
+      }
+
+      return result;
+    }
+
+    //maps a file holding one stored string, or nothing if it can not be read or does not hold one
+    static auto open(const std::string& path) -> std::optional<LMappedString> {
+
+      auto file = LMappedFile::open(path);
+
+      if(!file) {
+
+        return std::nullopt;
+      }
+
+      LBinaryReader reader(file->data(), file->size());
+
+      return parse(reader, file);
+    }
+
+    auto size() const noexcept -> size_t {
+
+      return size_;
+    }
+
+    auto empty() const noexcept -> bool {
+
+      return size_ == 0;
+    }
+
+    auto id(size_t index) const noexcept -> LSymbolId {
+
+      return ids_[index];
+    }
+
+    auto type(size_t index) const noexcept -> const LSymbolType<T>& {
+
+      return registry_.type(ids_[index]);
+    }
+
+    auto operator[](size_t index) const noexcept -> LSymbolView<T> {
+
+      return LSymbolView<T>(type(index), (offsets_ == nullptr) ? arena_ : arena_ + offsets_[index]);
+    }
+
+    auto registry() const noexcept -> const LSymbolRegistry<T, Hash>& {
+
+      return registry_;
+    }
+
+    auto toCompact() const -> LCompactString<T, Hash> {
+
+      std::vector<size_t> offsets(offsets_ == nullptr ? 0 : size_);
+
+      std::copy(offsets_, offsets_ + offsets.size(), offsets.begin());
+
+      return LCompactString<T, Hash>(registry_, std::vector<LSymbolId>(ids_, ids_ + size_), std::vector<unsigned char>(arena_, arena_ + arenaSize_), std::move(offsets));
+    }
+
+    auto toLString() const -> LString<T> {
+
+      LString<T> result;
+      result.reserve(size_);
+
+      for(size_t i = 0; i < size_; ++i) {
+
+        result.emplace_back((*this)[i].symbol());
+      }
+
+      return result;
+    }
+  };
+
+  //writes a string in the binary format, returning whether the stream took it all
+  template <typename T, typename Hash>
+  auto save(std::ostream& out, const LCompactString<T, Hash>& lstring) -> bool {
+
+    LBinaryWriter writer(out);
+    writeString(writer, lstring);
+
+    return writer.good();
+  }
+
+  template <typename T, typename Hash = std::hash<T>>
+  auto save(std::ostream& out, const LString<T>& lstring) -> bool {
+
+    LBinaryWriter writer(out);
+    writeString<T, Hash>(writer, lstring);
+
+    return writer.good();
+  }
+
+  //reads a whole stream holding one stored string, or nothing if it does not hold one
+  template <typename T, typename Hash = std::hash<T>>
+  auto loadString(std::istream& in) -> std::optional<LCompactString<T, Hash>> {
+
+    const auto bytes = std::make_shared<const std::vector<unsigned char>>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+    LBinaryReader reader(bytes->data(), bytes->size());
+    auto mapped = LMappedString<T, Hash>::parse(reader, bytes);
+
+    return mapped ? std::optional<LCompactString<T, Hash>>(mapped->toCompact()) : std::nullopt;
+  }
+}
+
+#endif
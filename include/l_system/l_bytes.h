@@ -0,0 +1,372 @@
+#ifndef L_SYSTEM_BYTES_H
+#define L_SYSTEM_BYTES_H
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cassert>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define L_SYSTEM_SSE2 1
+#endif
+
+#include "l_system/l_static.h"
+
+namespace l_system {
+
+  //bytes copied for every symbol rewritten, successors up to this long are copied with one vector store
+  constexpr const static size_t LBYTE_WIDTH = 16;
+
+  //bytes compared at once when looking for symbols to rewrite
+  constexpr const static size_t LBYTE_BLOCK = 16;
+
+  //the most rewritten symbols a block is compared against, systems rewriting more symbols look every byte up in the table
+  constexpr const static size_t LBYTE_COMPARED = 8;
+
+  //generates a char system without parameters, guards, contexts or alternatives over raw bytes rather than symbols
+  //rules become a table of 256 successors, each padded to LBYTE_WIDTH, so rewriting a byte is a fixed size copy and an advance by its length
+  //blocks holding no symbol which is rewritten are copied whole, and systems whose successors are all single symbols are substituted a block at a time
+  class LByteSystem {
+
+    std::vector<char> axiom_;
+    std::array<std::array<char, LBYTE_WIDTH>, 256> successors_{}; //the first LBYTE_WIDTH bytes of each successor
+    std::array<size_t, 256> lengths_{};
+    std::array<std::string, 256> longSuccessors_; //successors longer than LBYTE_WIDTH, whole
+    std::vector<unsigned char> rewritten_; //the symbols not kept as they are
+    bool substitution_ = true; //whether every successor is a single symbol
+    bool long_ = false; //whether any successor is longer than LBYTE_WIDTH
+
+    static auto byte(char symbol) noexcept -> size_t {
+
+      return static_cast<unsigned char>(symbol);
+    }
+
+    void setSuccessor(size_t symbol, const std::string& successor) {
+
+      memcpy(successors_[symbol].data(), successor.data(), std::min(successor.size(), LBYTE_WIDTH));
+      lengths_[symbol] = successor.size();
+
+      if(successor.size() > LBYTE_WIDTH) {
+
+        longSuccessors_[symbol] = successor;
+        long_ = true;
+      }
+
+      if(successor.size() != 1 || byte(successor[0]) != symbol) {
+
+        rewritten_.emplace_back(static_cast<unsigned char>(symbol));
+        substitution_ = substitution_ && successor.size() == 1;
+      }
+    }
+
+    //whether blocks are compared against the rewritten symbols
+    auto compared() const noexcept -> bool {
+
+#ifdef L_SYSTEM_SSE2
+      return rewritten_.size() <= LBYTE_COMPARED;
+#else
+      return false;
+#endif
+    }
+
+#ifdef L_SYSTEM_SSE2
+
+    static auto load(const char* data) noexcept -> __m128i {
+
+      return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    }
+
+    static void store(char* data, __m128i block) noexcept {
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(data), block);
+    }
+
+    //a bit for each byte of block which is rewritten
+    auto rewrittenMask(__m128i block) const noexcept -> int {
+
+      auto found = _mm_setzero_si128();
+
+      for(auto symbol : rewritten_) {
+
+        found = _mm_or_si128(found, _mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(symbol))));
+      }
+
+      return _mm_movemask_epi8(found);
+    }
+
+#endif
+
+    //rewrites one symbol at out, which must have room for LBYTE_WIDTH bytes, returning the end of its successor
+    template <bool Long>
+    auto rewriteSymbol(char symbol, char* out) const noexcept -> char* {
+
+      const auto i = byte(symbol);
+
+      memcpy(out, successors_[i].data(), LBYTE_WIDTH);
+
+      if(Long && lengths_[i] > LBYTE_WIDTH) {
+
+        memcpy(out, longSuccessors_[i].data(), lengths_[i]);
+      }
+
+      return out + lengths_[i];
+    }
+
+    template <bool Long>
+    auto rewriteSymbols(const char* in, size_t size, char* out) const noexcept -> char* {
+
+      size_t n = 0;
+
+#ifdef L_SYSTEM_SSE2
+      if(compared()) {
+
+        for(; n + LBYTE_BLOCK <= size; n += LBYTE_BLOCK) {
+
+          const auto block = load(in + n);
+
+          //runs of kept symbols are copied a block at a time
+          if(rewrittenMask(block) == 0) {
+
+            store(out, block);
+            out += LBYTE_BLOCK;
+            continue;
+          }
+
+          for(size_t i = 0; i < LBYTE_BLOCK; ++i) {
+
+            out = rewriteSymbol<Long>(in[n + i], out);
+          }
+        }
+      }
+#endif
+
+      for(; n < size; ++n) {
+
+        out = rewriteSymbol<Long>(in[n], out);
+      }
+
+      return out;
+    }
+
+    //replaces every symbol by its single symbol successor
+    void substitute(const char* in, size_t size, char* out) const noexcept {
+
+      size_t n = 0;
+
+#ifdef L_SYSTEM_SSE2
+      if(compared()) {
+
+        for(; n + LBYTE_BLOCK <= size; n += LBYTE_BLOCK) {
+
+          const auto block = load(in + n);
+          auto result = block;
+
+          for(auto symbol : rewritten_) {
+
+            const auto found = _mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(symbol)));
+            const auto successor = _mm_set1_epi8(successors_[symbol][0]);
+
+            result = _mm_or_si128(_mm_and_si128(found, successor), _mm_andnot_si128(found, result));
+          }
+
+          store(out + n, result);
+        }
+      }
+#endif
+
+      for(; n < size; ++n) {
+
+        out[n] = successors_[byte(in[n])][0];
+      }
+    }
+
+  public:
+
+    //the byte engine for a system, or nothing if the system has parameters or rules which do not rewrite every symbol of a type alike
+    template <typename Hash>
+    static auto from(const LSystem<char, Hash>& system) -> std::optional<LByteSystem> {
+
+      const auto& table = system.compiled();
+
+      if(!table.uniform()) {
+
+        return std::nullopt;
+      }
+
+      for(const auto& type : system.getAllSymbolTypes()) {
+
+        if(type.paramSet() != LNONE) {
+
+          return std::nullopt;
+        }
+      }
+
+      LByteSystem result;
+
+      for(const auto& symbol : system.axiom()) {
+
+        result.axiom_.emplace_back(symbol.type().representation());
+      }
+
+      for(size_t symbol = 0; symbol < 256; ++symbol) {
+
+        const auto rule = table.find(LSymbolType<char>(static_cast<char>(symbol)));
+        std::string successor(1, static_cast<char>(symbol));
+
+        if(rule != NO_RULE) {
+
+          successor.clear();
+
+          for(const auto& produced : table.successor(rule)) {
+
+            successor.push_back(produced.type().representation());
+          }
+        }
+
+        result.setSuccessor(symbol, successor);
+      }
+
+      return result;
+    }
+
+    //the exact length size bytes rewrite to
+    auto rewrittenLength(const char* in, size_t size) const noexcept -> size_t {
+
+      if(substitution_) {
+
+        return size;
+      }
+
+      size_t length = 0;
+      size_t n = 0;
+
+#ifdef L_SYSTEM_SSE2
+      if(compared()) {
+
+        //every byte adds its successor's length, kept bytes adding 1, so each rewritten symbol's occurrences are counted instead
+        std::array<size_t, LBYTE_COMPARED> counts{};
+
+        for(; n + LBYTE_BLOCK <= size; n += LBYTE_BLOCK) {
+
+          const auto block = load(in + n);
+
+          for(size_t s = 0; s < rewritten_.size(); ++s) {
+
+            const auto found = _mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(rewritten_[s]))));
+
+            counts[s] += std::bitset<LBYTE_BLOCK>(static_cast<unsigned long long>(found)).count();
+          }
+        }
+
+        length = n;
+
+        for(size_t s = 0; s < rewritten_.size(); ++s) {
+
+          length = length - counts[s] + counts[s] * lengths_[rewritten_[s]];
+        }
+      }
+#endif
+
+      for(; n < size; ++n) {
+
+        length += lengths_[byte(in[n])];
+      }
+
+      return length;
+    }
+
+    //rewrites size bytes into out, which must have room for rewrittenLength(in, size) + LBYTE_WIDTH bytes, returning the end of what was written
+    auto rewrite(const char* in, size_t size, char* out) const noexcept -> char* {
+
+      if(substitution_) {
+
+        substitute(in, size, out);
+
+        return out + size;
+      }
+
+      return long_ ? rewriteSymbols<true>(in, size, out) : rewriteSymbols<false>(in, size, out);
+    }
+
+    auto axiom() const -> LStaticString<char> {
+
+      return LStaticString<char>(axiom_);
+    }
+
+    //the length of each generation up to generations, from how often each byte occurs rather than from the generations themselves
+    auto lengths(int generations) const -> std::vector<LCount> {
+
+      std::array<LCount, 256> counts{};
+
+      for(auto symbol : axiom_) {
+
+        ++counts[byte(symbol)];
+      }
+
+      std::vector<LCount> result{axiom_.size()};
+
+      for(int i = 0; i < generations; ++i) {
+
+        std::array<LCount, 256> next{};
+        LCount total = 0;
+
+        for(size_t symbol = 0; symbol < 256; ++symbol) {
+
+          if(counts[symbol] == 0) {
+
+            continue;
+          }
+
+          const auto* successor = lengths_[symbol] > LBYTE_WIDTH ? longSuccessors_[symbol].data() : successors_[symbol].data();
+
+          for(size_t n = 0; n < lengths_[symbol]; ++n) {
+
+            auto& count = next[byte(successor[n])];
+
+            count = saturatingAdd(count, counts[symbol]);
+          }
+
+          total = saturatingAdd(total, saturatingMultiply(counts[symbol], lengths_[symbol]));
+        }
+
+        counts = next;
+        result.push_back(total);
+      }
+
+      return result;
+    }
+
+    //rewrites the axiom generations times between two buffers, both allocated once for the longest generation along the way
+    //throws std::length_error if a generation along the way is too long to be held, as its length then saturates
+    auto generate(int generations) const -> LStaticString<char> {
+
+      const auto sizes = lengths(generations);
+      const auto longest = *std::max_element(sizes.begin(), sizes.end());
+
+      std::vector<char> current(bufferSize<char>(longest, LBYTE_WIDTH));
+      std::vector<char> next(current.size());
+
+      std::copy(axiom_.begin(), axiom_.end(), current.begin());
+
+      auto size = axiom_.size();
+
+      for(int i = 0; i < generations; ++i) {
+
+        size = static_cast<size_t>(rewrite(current.data(), size, next.data()) - next.data());
+        std::swap(current, next);
+      }
+
+      current.resize(size);
+
+      return LStaticString<char>(std::move(current));
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,330 @@
+#ifndef L_SYSTEM_COMPACT_H
+#define L_SYSTEM_COMPACT_H
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "l_system/l_symbol.h"
+#include "l_system/l_registry.h"
+
+namespace l_system {
+
+  template <typename T, typename Hash>
+  class LRuleTable;
+
+  //a read only view of one symbol of an LCompactString, with the parameter accessors of LSymbol
+  template <typename T>
+  class LSymbolView {
+
+    const LSymbolType<T>* type_;
+    const unsigned char* parameters_;
+
+  public:
+
+    LSymbolView(const LSymbolType<T>& type, const unsigned char* parameters) : type_(&type), parameters_(parameters) {}
+
+    auto type() const noexcept -> const LSymbolType<T>& {
+
+      return *type_;
+    }
+
+    auto paramSet() const noexcept -> LParameterSet {
+
+      return type_->paramSet();
+    }
+
+    auto customParamSize() const noexcept -> LParameterCustomSize {
+
+      return type_->customParamSize();
+    }
+
+    auto getCharParam(LParameterCount n) const noexcept -> char {
+
+      assert(n < parameterCount(paramSet(), LCHAR) && "out of bounds parameter access.");
+
+      return readParameter<char>(parameters_, parameterOffset(paramSet(), LCHAR) + n);
+    }
+
+    auto getIntParam(LParameterCount n) const noexcept -> int {
+
+      assert(n < parameterCount(paramSet(), LINT) && "out of bounds parameter access.");
+
+      return readParameter<int>(parameters_, parameterOffset(paramSet(), LINT) + n * sizeof(int));
+    }
+
+    auto getFloatParam(LParameterCount n) const noexcept -> float {
+
+      assert(n < parameterCount(paramSet(), LFLOAT) && "out of bounds parameter access.");
+
+      return readParameter<float>(parameters_, parameterOffset(paramSet(), LFLOAT) + n * sizeof(float));
+    }
+
+    auto getCustomParam(LParameterCount n) const noexcept -> std::vector<unsigned char> {
+
+      assert(n < parameterCount(paramSet(), LCUSTOM) && "out of bounds parameter access.");
+
+      const auto* first = parameters_ + parameterOffset(paramSet(), LCUSTOM) + static_cast<size_t>(n * customParamSize());
+
+      return std::vector<unsigned char>(first, first + customParamSize());
+    }
+
+    //the raw parameter bytes, laid out as in LParameterData
+    auto data() const noexcept -> const unsigned char* {
+
+      return parameters_;
+    }
+
+    //copies the viewed symbol out into a standalone LSymbol
+    auto symbol() const noexcept -> LSymbol<T> {
+
+      LSymbol<T> result(*type_);
+
+      std::copy(parameters_, parameters_ + result.parameters().size(), result.parameters().data());
+
+      return result;
+    }
+  };
+
+  //a structure of arrays alternative to LString
+  //symbols are stored as ids into a registry of distinct symbol types, and all parameter data shares one byte arena
+  //a parameterless system costs one id per symbol, parameterized symbols add an arena offset and their data
+  template <typename T, typename Hash = std::hash<T>>
+  class LCompactString {
+
+    friend class LRuleTable<T, Hash>;
+
+    std::shared_ptr<LSymbolRegistry<T, Hash>> registry_; //id -> symbol type, shared with the strings rewritten from or into this one
+    std::vector<LSymbolId> ids_; //the symbols in order
+    std::vector<unsigned char> arena_; //the parameter data of every symbol, back to back
+    std::vector<size_t> offsets_; //each symbol's parameter data offset into arena_, left empty while no symbol has parameters
+
+    auto parameters(size_t index) const noexcept -> const unsigned char* {
+
+      return offsets_.empty() ? arena_.data() : arena_.data() + offsets_[index];
+    }
+
+    //the registry, copied first if another string shares it, as interning may add types the others should not see
+    auto ownRegistry() -> LSymbolRegistry<T, Hash>& {
+
+      if(!registry_) {
+
+        registry_ = std::make_shared<LSymbolRegistry<T, Hash>>(); //moved from
+      }
+      else if(registry_.use_count() > 1) {
+
+        registry_ = std::make_shared<LSymbolRegistry<T, Hash>>(*registry_);
+      }
+
+      return *registry_;
+    }
+
+    //appends a symbol with room for its parameter data, returning that space
+    auto append(const LSymbolType<T>& type) -> unsigned char* {
+
+      const auto id = ownRegistry().intern(type);
+      const auto dataSize = requiredDataSize(type.paramSet(), type.customParamSize());
+
+      if(dataSize > 0 && offsets_.empty()) {
+
+        offsets_.assign(ids_.size(), arena_.size());
+      }
+
+      if(dataSize > 0 || !offsets_.empty()) {
+
+        offsets_.emplace_back(arena_.size());
+      }
+
+      ids_.emplace_back(id);
+      arena_.resize(arena_.size() + dataSize);
+
+      return arena_.data() + arena_.size() - dataSize;
+    }
+
+  public:
+
+    LCompactString() : registry_(std::make_shared<LSymbolRegistry<T, Hash>>()) {}
+
+    //an empty string which starts out with a registry's ids, e.g. those of a system's rules
+    LCompactString(const LSymbolRegistry<T, Hash>& registry) : registry_(std::make_shared<LSymbolRegistry<T, Hash>>(registry)) {}
+
+    //assembles a string from its parts, as the binary format stores them, offsets may be empty if no symbol has parameters
+    LCompactString(LSymbolRegistry<T, Hash> registry, std::vector<LSymbolId> ids, std::vector<unsigned char> arena, std::vector<size_t> offsets) :
+      registry_(std::make_shared<LSymbolRegistry<T, Hash>>(std::move(registry))),
+      ids_(std::move(ids)),
+      arena_(std::move(arena)),
+      offsets_(std::move(offsets)) {
+
+      assert((offsets_.empty() || offsets_.size() == ids_.size()) && "one offset is needed per symbol.");
+    }
+
+    LCompactString(const LString<T>& lstring) : LCompactString() {
+
+      ids_.reserve(lstring.size());
+
+      for(const auto& symbol : lstring) {
+
+        push_back(symbol);
+      }
+    }
+
+    void push_back(const LSymbol<T>& symbol) {
+
+      auto* data = append(symbol.type());
+
+      std::copy(symbol.parameters().data(), symbol.parameters().data() + symbol.parameters().size(), data);
+    }
+
+    //appends a symbol with zeroed parameters
+    void push_back(const LSymbolType<T>& type) {
+
+      auto* data = append(type);
+
+      std::fill(data, data + requiredDataSize(type.paramSet(), type.customParamSize()), 0);
+    }
+
+    void reserve(size_t symbols) {
+
+      ids_.reserve(symbols);
+    }
+
+    void clear() noexcept {
+
+      ids_.clear();
+      arena_.clear();
+      offsets_.clear();
+    }
+
+    auto size() const noexcept -> size_t {
+
+      return ids_.size();
+    }
+
+    auto empty() const noexcept -> bool {
+
+      return ids_.empty();
+    }
+
+    auto operator[](size_t index) const noexcept -> LSymbolView<T> {
+
+      return LSymbolView<T>(registry_->type(ids_[index]), parameters(index));
+    }
+
+    auto id(size_t index) const noexcept -> LSymbolId {
+
+      return ids_[index];
+    }
+
+    auto type(size_t index) const noexcept -> const LSymbolType<T>& {
+
+      return registry_->type(ids_[index]);
+    }
+
+    auto registry() const noexcept -> const LSymbolRegistry<T, Hash>& {
+
+      return *registry_;
+    }
+
+    auto ids() const noexcept -> const std::vector<LSymbolId>& {
+
+      return ids_;
+    }
+
+    auto arena() const noexcept -> const std::vector<unsigned char>& {
+
+      return arena_;
+    }
+
+    //each symbol's offset into the arena, empty while no symbol has parameters
+    auto offsets() const noexcept -> const std::vector<size_t>& {
+
+      return offsets_;
+    }
+
+    //the bytes held for the symbols themselves, not counting the type table
+    auto memoryUsage() const noexcept -> size_t {
+
+      return ids_.capacity() * sizeof(LSymbolId) + arena_.capacity() + offsets_.capacity() * sizeof(size_t);
+    }
+
+    auto toLString() const -> LString<T> {
+
+      LString<T> result;
+      result.reserve(size());
+
+      for(size_t i = 0; i < size(); ++i) {
+
+        result.emplace_back((*this)[i].symbol());
+      }
+
+      return result;
+    }
+  };
+
+  //the text of each type of a registry, by id
+  template <typename T, typename Hash>
+  auto representations(const LSymbolRegistry<T, Hash>& registry) -> std::vector<std::string> {
+
+    std::vector<std::string> result(registry.size());
+
+    for(LSymbolId id = 0; id < registry.size(); ++id) {
+
+      appendRepresentation(result[id], registry.type(id).representation());
+    }
+
+    return result;
+  }
+
+  //appends the text of symbols [first, last) of a compact string, texts holding representations(lstring.registry())
+  //each symbol copies its type's text, and when every text is one character, as for char systems, symbols are single stores
+  template <typename T, typename Hash>
+  void appendSymbols(std::string& out, const LCompactString<T, Hash>& lstring, size_t first, size_t last, const std::vector<std::string>& texts, bool showParams) {
+
+    const auto single = std::all_of(texts.begin(), texts.end(), [](const auto& text) { return text.size() == 1; });
+
+    if(single && !showParams) {
+
+      std::vector<char> characters(texts.size());
+      std::transform(texts.begin(), texts.end(), characters.begin(), [](const auto& text) { return text.front(); });
+
+      const auto size = out.size();
+
+      out.resize(size + last - first);
+
+      auto* text = out.data() + size;
+
+      for(size_t i = first; i < last; ++i) {
+
+        *text++ = characters[lstring.id(i)];
+      }
+
+      return;
+    }
+
+    for(size_t i = first; i < last; ++i) {
+
+      const auto symbol = lstring[i];
+
+      out += texts[lstring.id(i)];
+
+      if(!empty(symbol.paramSet()) && showParams) {
+
+        appendParameters(out, symbol.paramSet(), symbol.customParamSize(), symbol.data());
+      }
+    }
+  }
+
+  template <typename T, typename Hash>
+  auto represent(const LCompactString<T, Hash>& lstring, bool showParams = false) noexcept -> std::string {
+
+    std::string result;
+
+    appendSymbols(result, lstring, 0, lstring.size(), representations(lstring.registry()), showParams);
+
+    return result;
+  }
+}
+
+#endif
@@ -0,0 +1,240 @@
+#ifndef L_SYSTEM_CONTEXT_H
+#define L_SYSTEM_CONTEXT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "l_system/l_rule.h"
+#include "l_system/l_registry.h"
+
+namespace l_system {
+
+  //the symbols which give a string its branch structure, and those context matching looks through
+  template <typename T>
+  struct LContextOptions {
+
+    std::optional<LSymbolType<T>> push; //opens a branch, e.g. '['
+    std::optional<LSymbolType<T>> pop; //closes a branch, e.g. ']'
+    LTypeString<T> ignored; //never part of a context, e.g. turtle turns
+  };
+
+  //an Aho-Corasick automaton over symbol ids, its state after a sequence tells which patterns end that sequence
+  class LContextAutomaton {
+
+    using State = std::uint32_t;
+
+    std::vector<std::vector<std::pair<LSymbolId, State>>> children_; //the trie of patterns, only used while building
+    std::vector<std::vector<std::uint32_t>> matches_; //state -> sorted patterns ending at it, directly or through suffixes
+    std::vector<State> delta_; //state * alphabet_ + id -> next state
+    size_t alphabet_ = 1;
+    std::uint32_t patterns_ = 0;
+
+  public:
+
+    LContextAutomaton() : children_(1), matches_(1) {}
+
+    auto add(const std::vector<LSymbolId>& pattern) -> std::uint32_t {
+
+      State state = 0;
+
+      for(auto id : pattern) {
+
+        auto& children = children_[state];
+        auto child = std::find_if(children.begin(), children.end(), [&](const auto& entry) { return entry.first == id; });
+
+        if(child != children.end()) {
+
+          state = child->second;
+          continue;
+        }
+
+        children.emplace_back(id, static_cast<State>(children_.size()));
+        state = static_cast<State>(children_.size());
+        children_.emplace_back();
+        matches_.emplace_back();
+      }
+
+      matches_[state].emplace_back(patterns_);
+
+      return patterns_++;
+    }
+
+    //builds the transition table for ids below symbols, every other id shares one extra column
+    void compile(size_t symbols) {
+
+      alphabet_ = symbols + 1;
+      delta_.assign(children_.size() * alphabet_, 0);
+
+      std::vector<State> fail(children_.size(), 0);
+      std::vector<State> queue = {0};
+
+      for(size_t head = 0; head < queue.size(); ++head) {
+
+        const auto state = queue[head];
+
+        for(size_t id = 0; id < alphabet_; ++id) {
+
+          delta_[state * alphabet_ + id] = (state == 0) ? 0 : delta_[fail[state] * alphabet_ + id];
+        }
+
+        for(const auto& [id, child] : children_[state]) {
+
+          fail[child] = (state == 0) ? 0 : delta_[fail[state] * alphabet_ + id];
+          delta_[state * alphabet_ + id] = child;
+
+          auto& matches = matches_[child];
+          matches.insert(matches.end(), matches_[fail[child]].begin(), matches_[fail[child]].end());
+          std::sort(matches.begin(), matches.end());
+
+          queue.emplace_back(child);
+        }
+      }
+
+      children_.clear();
+    }
+
+    auto next(State state, LSymbolId id) const noexcept -> State {
+
+      return delta_[state * alphabet_ + std::min<size_t>(id, alphabet_ - 1)];
+    }
+
+    auto matches(State state, std::uint32_t pattern) const noexcept -> bool {
+
+      return std::binary_search(matches_[state].begin(), matches_[state].end(), pattern);
+    }
+  };
+
+  //finds the contexts of every symbol of a string in two linear passes, without rescanning neighbours
+  //left contexts are found by one automaton run left to right, right contexts by one over reversed patterns run right to left
+  //a branch inherits the left context of the symbol before it, and is skipped by the right context of that symbol
+  class LContextMatcher {
+
+    constexpr const static std::uint32_t NO_PATTERN = std::numeric_limits<std::uint32_t>::max();
+
+    LContextAutomaton left_;
+    LContextAutomaton right_;
+    std::vector<std::uint32_t> leftPatterns_; //rule -> its left context pattern, or NO_PATTERN
+    std::vector<std::uint32_t> rightPatterns_; //rule -> its reversed right context pattern, or NO_PATTERN
+    std::vector<bool> ignored_; //id -> whether contexts look through it
+    LSymbolId push_ = NO_SYMBOL;
+    LSymbolId pop_ = NO_SYMBOL;
+
+    auto isIgnored(LSymbolId id) const noexcept -> bool {
+
+      return id < ignored_.size() && ignored_[id];
+    }
+
+    auto isPush(LSymbolId id) const noexcept -> bool {
+
+      return push_ != NO_SYMBOL && id == push_;
+    }
+
+    auto isPop(LSymbolId id) const noexcept -> bool {
+
+      return pop_ != NO_SYMBOL && id == pop_;
+    }
+
+  public:
+
+    //rules are given by their context ids, interned into a registry of size symbols
+    void build(const std::vector<std::vector<LSymbolId>>& lefts, const std::vector<std::vector<LSymbolId>>& rights, size_t symbols, LSymbolId push, LSymbolId pop, const std::vector<LSymbolId>& ignored) {
+
+      *this = LContextMatcher();
+
+      push_ = push;
+      pop_ = pop;
+      ignored_.assign(symbols, false);
+
+      for(auto id : ignored) {
+
+        ignored_[id] = true;
+      }
+
+      for(size_t rule = 0; rule < lefts.size(); ++rule) {
+
+        leftPatterns_.emplace_back(lefts[rule].empty() ? NO_PATTERN : left_.add(lefts[rule]));
+        rightPatterns_.emplace_back(rights[rule].empty() ? NO_PATTERN : right_.add(std::vector<LSymbolId>(rights[rule].rbegin(), rights[rule].rend())));
+      }
+
+      left_.compile(symbols);
+      right_.compile(symbols);
+    }
+
+    //whether a rule's contexts match a symbol, given the states states() found for it
+    auto matches(LRuleIndex rule, std::uint32_t left, std::uint32_t right) const noexcept -> bool {
+
+      return (leftPatterns_[rule] == NO_PATTERN || left_.matches(left, leftPatterns_[rule]))
+        && (rightPatterns_[rule] == NO_PATTERN || right_.matches(right, rightPatterns_[rule]));
+    }
+
+    //writes the context states of each of size symbols to lefts and rights, idAt(i) is the registry id of symbol i
+    template <typename F>
+    void states(size_t size, F&& idAt, std::uint32_t* lefts, std::uint32_t* rights) const {
+
+      std::vector<std::uint32_t> branches;
+      std::uint32_t state = 0;
+
+      //right to left, a branch's closing symbol starts a fresh context, and its opening symbol restores the one after the branch
+      for(size_t i = size; i-- > 0;) {
+
+        const LSymbolId id = idAt(i);
+
+        rights[i] = state;
+
+        if(isPop(id)) {
+
+          branches.emplace_back(state);
+          state = 0;
+        }
+        else if(isPush(id)) {
+
+          state = branches.empty() ? 0 : branches.back();
+
+          if(!branches.empty()) {
+
+            branches.pop_back();
+          }
+        }
+        else if(!isIgnored(id)) {
+
+          state = right_.next(state, id);
+        }
+      }
+
+      branches.clear();
+      state = 0;
+
+      //left to right, a branch continues from the context before it, and closing it returns to that context
+      for(size_t i = 0; i < size; ++i) {
+
+        const LSymbolId id = idAt(i);
+
+        lefts[i] = state;
+
+        if(isPush(id)) {
+
+          branches.emplace_back(state);
+        }
+        else if(isPop(id)) {
+
+          state = branches.empty() ? 0 : branches.back();
+
+          if(!branches.empty()) {
+
+            branches.pop_back();
+          }
+        }
+        else if(!isIgnored(id)) {
+
+          state = left_.next(state, id);
+        }
+      }
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef L_SYSTEM_DAG_H
+#define L_SYSTEM_DAG_H
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "l_system/l_growth.h"
+
+namespace l_system {
+
+  //a compressed generation of a deterministic context-free system without guards or parameter expressions
+  //expanding a symbol type for d generations always gives the same string, so generation n is a DAG of shared (type, depth) nodes
+  //a node is its type's successor at depth - 1, or the symbol itself at depth 0 or without a rule, only node lengths are stored
+  //memory is O(types * generations) however long the generation is, and symbols are produced on demand by descending the DAG
+  //the derivation copies the system's axiom and rules, later changes to the system are not reflected
+  template <typename T, typename Hash = std::hash<T>>
+  class LDerivation {
+
+    LGrowth<T, Hash> growth_; //the per type expansion lengths, which are the DAG's node lengths
+    int generations_;
+    LCount length_; //saturated length of the whole generation
+
+    LDerivation(LGrowth<T, Hash> growth, int generations) : growth_(std::move(growth)), generations_(std::max(0, generations)), length_(growth_.saturatedLength(generations_)) {}
+
+  public:
+
+    using iterator = typename LGrowth<T, Hash>::iterator;
+
+    //a range of a derivation, iterated lazily without producing the symbols around it
+    class slice_type {
+
+      const LDerivation* derivation_;
+      LCount begin_;
+      LCount end_;
+
+    public:
+
+      slice_type(const LDerivation& derivation, LCount begin, LCount end) : derivation_(&derivation), begin_(begin), end_(end) {}
+
+      auto begin() const -> iterator {
+
+        return iterator(derivation_->growth_, derivation_->generations_, begin_);
+      }
+
+      auto end() const noexcept -> iterator {
+
+        return iterator::sentinel(end_);
+      }
+
+      auto size() const noexcept -> LCount {
+
+        return end_ - begin_;
+      }
+
+      auto materialize() const -> LString<T> {
+
+        return derivation_->materialize(begin_, end_);
+      }
+    };
+
+    //the derivation of a generation, or nothing if the system's rules are not uniform, as LGrowth::analyze refuses them
+    //a negative number of generations is the axiom, as with generate
+    static auto derive(const LSystem<T, Hash>& system, int generations) -> std::optional<LDerivation> {
+
+      auto growth = LGrowth<T, Hash>::analyze(system);
+
+      if(!growth) {
+
+        return std::nullopt;
+      }
+
+      return LDerivation(std::move(*growth), generations);
+    }
+
+    auto generations() const noexcept -> int {
+
+      return generations_;
+    }
+
+    //the length of the generation, or nothing if it does not fit in an LCount
+    auto length() const noexcept -> std::optional<LCount> {
+
+      return (length_ == LCOUNT_OVERFLOW) ? std::nullopt : std::optional<LCount>(length_);
+    }
+
+    //the number of distinct (type, depth) nodes the generation is built from
+    auto nodeCount() const noexcept -> size_t {
+
+      return (static_cast<size_t>(generations_) + 1) * growth_.types().size();
+    }
+
+    auto begin() const -> iterator {
+
+      return iterator(growth_, generations_, 0);
+    }
+
+    auto end() const noexcept -> iterator {
+
+      return iterator::sentinel(length_);
+    }
+
+    //the symbol at an index, which must be less than the length
+    auto at(LCount index) const -> LSymbol<T> {
+
+      assert(index < length_ && "out of bounds derivation access.");
+
+      return *iterator(growth_, generations_, index);
+    }
+
+    auto slice(LCount begin, LCount end) const noexcept -> slice_type {
+
+      begin = std::min(begin, length_);
+
+      return slice_type(*this, begin, std::max(begin, std::min(end, length_)));
+    }
+
+    auto materialize(LCount begin, LCount end) const -> LString<T> {
+
+      begin = std::min(begin, length_);
+      end = std::max(begin, std::min(end, length_));
+
+      LString<T> result;
+      result.reserve(end - begin);
+
+      auto it = iterator(growth_, generations_, begin);
+
+      for(auto index = begin; index < end; ++index, ++it) {
+
+        result.emplace_back(*it);
+      }
+
+      return result;
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,340 @@
+#ifndef L_SYSTEM_DISK_H
+#define L_SYSTEM_DISK_H
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "l_system/l_binary.h"
+
+namespace l_system {
+
+  //bumped whenever the layout of a generation's index changes, indices of another version are refused
+  constexpr const static std::uint32_t LDISK_VERSION = 1;
+
+  //a generation kept on disk as a sequence of binary string files, each holding a run of consecutive symbols
+  //chunk n of generation g in a directory is always named directory/g-n.lstr, and an index directory/g.chunks lists them, so a generation can be found again by open
+  template <typename T, typename Hash = std::hash<T>>
+  class LDiskString {
+
+    std::string directory_;
+    int generation_ = 0;
+    std::vector<size_t> sizes_; //symbols per chunk
+    std::uint64_t size_ = 0;
+
+  public:
+
+    LDiskString() = default;
+
+    LDiskString(std::string directory, int generation) : directory_(std::move(directory)), generation_(generation) {}
+
+    //the file name of a chunk, relative to its directory
+    static auto chunkFile(int generation, size_t chunk) -> std::string {
+
+      return std::to_string(generation) + "-" + std::to_string(chunk) + ".lstr";
+    }
+
+    static auto chunkPath(const std::string& directory, int generation, size_t chunk) -> std::string {
+
+      return directory + "/" + chunkFile(generation, chunk);
+    }
+
+    //where the index of a generation's chunks is kept in a directory, beside them
+    static auto indexPath(const std::string& directory, int generation) -> std::string {
+
+      return directory + "/" + std::to_string(generation) + ".chunks";
+    }
+
+    //finds a generation written earlier from the index written with it, or nothing if the index or a chunk it lists is missing or of another size
+    //only the chunks listed are part of the generation, so files left past them by an earlier, longer write of it are ignored
+    //the chunks are mapped to check their sizes, not read
+    static auto open(const std::string& directory, int generation) -> std::optional<LDiskString> {
+
+      std::ifstream in(indexPath(directory, generation));
+      std::string word;
+      std::uint32_t version = 0;
+      int indexed = 0;
+      size_t chunks = 0;
+
+      if(!in || !(in >> word) || word != "ldisk" || !(in >> version) || version != LDISK_VERSION) {
+
+        return std::nullopt;
+      }
+
+      if(!(in >> word) || word != "generation" || !(in >> indexed) || indexed != generation || !(in >> word) || word != "chunks" || !(in >> chunks)) {
+
+        return std::nullopt;
+      }
+
+      LDiskString result(directory, generation);
+
+      for(size_t chunk = 0; chunk < chunks; ++chunk) {
+
+        size_t size = 0;
+
+        if(!(in >> size)) {
+
+          return std::nullopt;
+        }
+
+        const auto mapped = LMappedString<T, Hash>::open(chunkPath(directory, generation, chunk));
+
+        if(!mapped || mapped->size() != size) {
+
+          return std::nullopt;
+        }
+
+        result.append(size);
+      }
+
+      return result;
+    }
+
+    //writes the index open finds the generation by, as text, a header and then the symbols of each chunk in order
+    auto saveIndex() const -> bool {
+
+      std::ofstream out(indexPath(directory_, generation_));
+
+      out << "ldisk " << LDISK_VERSION << '\n';
+      out << "generation " << generation_ << '\n';
+      out << "chunks " << sizes_.size() << '\n';
+
+      for(const auto size : sizes_) {
+
+        out << size << '\n';
+      }
+
+      out.close();
+
+      return !out.fail();
+    }
+
+    //records the next chunk, whose file must already be written
+    void append(size_t size) {
+
+      sizes_.emplace_back(size);
+      size_ += size;
+    }
+
+    auto directory() const noexcept -> const std::string& {
+
+      return directory_;
+    }
+
+    auto generation() const noexcept -> int {
+
+      return generation_;
+    }
+
+    //the number of symbols over all chunks
+    auto size() const noexcept -> std::uint64_t {
+
+      return size_;
+    }
+
+    auto chunks() const noexcept -> size_t {
+
+      return sizes_.size();
+    }
+
+    auto chunkSize(size_t chunk) const noexcept -> size_t {
+
+      return sizes_[chunk];
+    }
+
+    auto path(size_t chunk) const -> std::string {
+
+      return chunkPath(directory_, generation_, chunk);
+    }
+
+    //maps a chunk without reading it
+    auto chunk(size_t n) const -> std::optional<LMappedString<T, Hash>> {
+
+      return LMappedString<T, Hash>::open(path(n));
+    }
+
+    auto load(size_t n) const -> std::optional<LString<T>> {
+
+      const auto mapped = chunk(n);
+
+      return mapped ? std::optional<LString<T>>(mapped->toLString()) : std::nullopt;
+    }
+
+    //reads the whole generation into memory, only sensible when it fits
+    auto materialize() const -> std::optional<LString<T>> {
+
+      LString<T> result;
+      result.reserve(static_cast<size_t>(size_));
+
+      for(size_t n = 0; n < chunks(); ++n) {
+
+        const auto mapped = chunk(n);
+
+        if(!mapped) {
+
+          return std::nullopt;
+        }
+
+        for(size_t i = 0; i < mapped->size(); ++i) {
+
+          result.emplace_back((*mapped)[i].symbol());
+        }
+      }
+
+      return result;
+    }
+
+    //deletes the chunk files and the index
+    void remove() const noexcept {
+
+      std::remove(indexPath(directory_, generation_).c_str());
+
+      for(size_t n = 0; n < chunks(); ++n) {
+
+        std::remove(path(n).c_str());
+      }
+    }
+  };
+
+  //reads the chunks of a disk string in order, loading the next chunk in the background while the caller works on the current one
+  template <typename T, typename Hash = std::hash<T>>
+  class LChunkReader {
+
+    const LDiskString<T, Hash>& lstring_;
+    size_t next_ = 0;
+    std::future<std::optional<LString<T>>> pending_;
+    bool failed_ = false;
+
+    void prefetch() {
+
+      if(next_ < lstring_.chunks()) {
+
+        pending_ = std::async(std::launch::async, [this, n = next_] { return lstring_.load(n); });
+      }
+    }
+
+  public:
+
+    LChunkReader(const LDiskString<T, Hash>& lstring) : lstring_(lstring) {
+
+      prefetch();
+    }
+
+    ~LChunkReader() {
+
+      if(pending_.valid()) {
+
+        pending_.wait();
+      }
+    }
+
+    LChunkReader(const LChunkReader&) = delete;
+    auto operator=(const LChunkReader&) -> LChunkReader& = delete;
+
+    //moves the next chunk into chunk, false once every chunk is read or a chunk could not be read
+    auto next(LString<T>& chunk) -> bool {
+
+      if(failed_ || next_ == lstring_.chunks()) {
+
+        return false;
+      }
+
+      auto loaded = pending_.get();
+
+      if(!loaded) {
+
+        failed_ = true;
+        return false;
+      }
+
+      chunk = std::move(*loaded);
+      ++next_;
+      prefetch();
+
+      return true;
+    }
+
+    auto failed() const noexcept -> bool {
+
+      return failed_;
+    }
+  };
+
+  //writes chunks of a generation in order, one in the background while the caller fills the next
+  //a written chunk's buffer is handed back to the caller, so two buffers are reused for the whole generation
+  template <typename T, typename Hash = std::hash<T>>
+  class LChunkWriter {
+
+    LDiskString<T, Hash> written_;
+    LString<T> buffer_; //the chunk being written
+    std::future<bool> pending_;
+    bool failed_ = false;
+
+    void wait() {
+
+      if(pending_.valid() && !pending_.get()) {
+
+        failed_ = true;
+      }
+    }
+
+  public:
+
+    //an index left by an earlier write of the generation is deleted first, so that an unfinished write is never opened as whole
+    LChunkWriter(const std::string& directory, int generation) : written_(directory, generation) {
+
+      std::remove(LDiskString<T, Hash>::indexPath(directory, generation).c_str());
+    }
+
+    ~LChunkWriter() {
+
+      if(pending_.valid()) {
+
+        pending_.wait();
+      }
+    }
+
+    LChunkWriter(const LChunkWriter&) = delete;
+    auto operator=(const LChunkWriter&) -> LChunkWriter& = delete;
+
+    //starts writing chunk as the next chunk file, leaving chunk holding an older buffer to refill, empty chunks are skipped
+    void write(LString<T>& chunk) {
+
+      if(chunk.empty()) {
+
+        return;
+      }
+
+      wait();
+      std::swap(buffer_, chunk);
+      chunk.clear();
+
+      pending_ = std::async(std::launch::async, [this, path = written_.path(written_.chunks())] {
+
+        std::ofstream out(path, std::ios::binary);
+
+        const auto saved = save<T, Hash>(out, buffer_);
+        out.close();
+
+        return saved && !out.fail();
+      });
+
+      written_.append(buffer_.size());
+    }
+
+    //waits for the last chunk and writes the index, giving the generation written or nothing if any chunk or the index could not be written
+    auto finish() -> std::optional<LDiskString<T, Hash>> {
+
+      wait();
+
+      return failed_ || !written_.saveIndex() ? std::nullopt : std::optional<LDiskString<T, Hash>>(written_);
+    }
+  };
+}
+
+#endif
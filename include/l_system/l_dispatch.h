@@ -0,0 +1,670 @@
+#ifndef L_SYSTEM_DISPATCH_H
+#define L_SYSTEM_DISPATCH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+
+#include "l_system/l_rule.h"
+#include "l_system/l_registry.h"
+#include "l_system/l_compact.h"
+#include "l_system/l_context.h"
+#include "l_system/l_random.h"
+#include "l_system/l_stats.h"
+
+namespace l_system {
+
+  //a compiled form of a rule set, answering "which rule rewrites this symbol" with a single lookup
+  //every type named by the rules is interned into a registry, and rules are then found by id
+  //each alternative result of a rule is a production, drawn in O(1) from an alias table over the rule's productions
+  //guards and parameter expressions are compiled into programs, evaluated for all the symbols of one rule or production at a time
+  template <typename T, typename Hash = std::hash<T>>
+  class LRuleTable {
+
+    //a parameter of one symbol of a production, computed from the parameters of the symbol it rewrites
+    struct LParameterTarget {
+
+      size_t symbol;
+      LParameter kind;
+      LParameterDataSize offset; //the parameter's byte offset within the symbol's data
+      LProgram program;
+    };
+
+    LSymbolRegistry<T, Hash> registry_;
+    std::vector<LRuleIndex> rules_; //symbol id -> index of the last rule which applies to it
+    std::vector<LRuleIndex> productions_; //rule -> its first production, the productions of a rule are consecutive
+    std::vector<LRuleIndex> alternativeCounts_; //rule -> its number of productions
+    std::vector<LString<T>> successors_; //the symbols of each production, prebuilt so rewriting is a copy
+    std::vector<std::vector<LSymbolId>> successorIds_; //the ids of the symbols of each production
+    std::vector<LParameterDataSize> successorDataSizes_; //the parameter bytes of each production
+    std::vector<std::uint64_t> thresholds_; //production -> draws below this, out of 2^32, keep it, the others take its alias
+    std::vector<LRuleIndex> aliases_; //production -> the production standing in for it above its threshold
+    std::vector<std::vector<LRuleIndex>> candidates_; //id -> rules for it, last added first, ending at the first unconditional one
+    std::vector<LProgram> guards_; //rule -> its compiled guard, empty if it has none
+    std::vector<std::vector<LParameterTarget>> targets_; //production -> the parameters its expressions set
+    LContextMatcher context_; //finds contexts, only built when a rule has a context
+    bool contextSensitive_ = false;
+    bool stochastic_ = false;
+    bool guarded_ = false;
+    bool parametric_ = false; //whether any production has parameter expressions
+
+    auto intern(const LTypeString<T>& types) -> std::vector<LSymbolId> {
+
+      std::vector<LSymbolId> ids;
+
+      for(const auto& type : types) {
+
+        ids.emplace_back(registry_.intern(type));
+      }
+
+      return ids;
+    }
+
+    auto ruleAt(const LSymbol<T>* symbols, const LRuleIndex* rules, size_t i) const noexcept -> LRuleIndex {
+
+      return (rules == nullptr) ? find(symbols[i].type()) : rules[i];
+    }
+
+    //the production drawn by symbol i of a range, without drawing for rules with a single one
+    auto production(LRuleIndex rule, const LRandomKey& key, size_t i) const noexcept -> LRuleIndex {
+
+      if(!stochastic_) {
+
+        return rule;
+      }
+
+      const auto first = productions_[rule];
+      const auto count = alternativeCounts_[rule];
+
+      if(count == 1) {
+
+        return first;
+      }
+
+      //the high half of the draw picks a column of the alias table, the low half decides between it and its alias
+      const auto draw = counterRandom(key, i);
+      const auto column = first + static_cast<LRuleIndex>(((draw >> 32) * count) >> 32);
+
+      return ((draw & 0xffffffffULL) < thresholds_[column]) ? column : aliases_[column];
+    }
+
+    //picks each symbol's rule, the last added one whose context matches and whose guard holds
+    //a guard is evaluated over every symbol waiting on its rule in batches, and a symbol failing it moves on to its next candidate
+    //candidates come in falling rule order, so one sweep over the rules from last to first settles every symbol
+    template <typename Id, typename Data>
+    void choose(size_t size, Id&& idAt, Data&& dataAt, LRuleIndex* rules) const {
+
+      std::vector<std::uint32_t> lefts(contextSensitive_ ? size : 0);
+      std::vector<std::uint32_t> rights(contextSensitive_ ? size : 0);
+
+      if(contextSensitive_) {
+
+        context_.states(size, idAt, lefts.data(), rights.data());
+      }
+
+      std::vector<std::vector<std::pair<size_t, size_t>>> waiting(guarded_ ? guards_.size() : 0); //rule -> (symbol, candidate position) waiting on its guard
+
+      //settles symbol i on the first of its candidates from position on whose context matches, unless that one has a guard to wait on
+      const auto advance = [&](size_t i, size_t position) {
+
+        const auto id = idAt(i);
+
+        for(; id < candidates_.size() && position < candidates_[id].size(); ++position) {
+
+          const auto rule = candidates_[id][position];
+
+          if(contextSensitive_ && !context_.matches(rule, lefts[i], rights[i])) {
+
+            continue;
+          }
+
+          if(guards_[rule].empty()) {
+
+            rules[i] = rule;
+          }
+          else {
+
+            waiting[rule].emplace_back(i, position);
+          }
+
+          return;
+        }
+
+        rules[i] = NO_RULE;
+      };
+
+      for(size_t i = 0; i < size; ++i) {
+
+        advance(i, 0);
+      }
+
+      std::vector<const unsigned char*> sources;
+      std::vector<float> results(LEXPRESSION_BATCH);
+      std::vector<float> stack;
+
+      for(size_t rule = waiting.size(); rule-- > 0;) {
+
+        const auto& symbols = waiting[rule];
+
+        for(size_t begin = 0; begin < symbols.size(); begin += LEXPRESSION_BATCH) {
+
+          const auto count = std::min(LEXPRESSION_BATCH, symbols.size() - begin);
+
+          sources.clear();
+
+          for(size_t k = 0; k < count; ++k) {
+
+            sources.emplace_back(dataAt(symbols[begin + k].first));
+          }
+
+          guards_[rule].evaluate(sources.data(), count, results.data(), stack);
+
+          for(size_t k = 0; k < count; ++k) {
+
+            const auto [i, position] = symbols[begin + k];
+
+            if(results[k] != 0.0f) {
+
+              rules[i] = static_cast<LRuleIndex>(rule);
+            }
+            else {
+
+              advance(i, position + 1);
+            }
+          }
+        }
+      }
+    }
+
+    //sets the parameters computed by expressions, once a range has been rewritten
+    //productionAt(i) is the production drawn for symbol i of the range or NO_RULE, sourceAt(i) its parameter data, and targetAt(j) that of symbol j of the rewriting
+    //symbols are collected per production, and each of its programs runs over a whole batch of them
+    template <typename P, typename S, typename D>
+    void evaluateExpressions(size_t size, P&& productionAt, S&& sourceAt, D&& targetAt) const {
+
+      std::vector<std::vector<std::pair<const unsigned char*, size_t>>> batches(targets_.size()); //production -> (source data, position of its rewriting)
+      std::vector<const unsigned char*> sources;
+      std::vector<float> values(LEXPRESSION_BATCH);
+      std::vector<float> stack;
+
+      const auto flush = [&](LRuleIndex production) {
+
+        auto& batch = batches[production];
+
+        sources.clear();
+
+        for(const auto& entry : batch) {
+
+          sources.emplace_back(entry.first);
+        }
+
+        for(const auto& target : targets_[production]) {
+
+          target.program.evaluate(sources.data(), batch.size(), values.data(), stack);
+
+          for(size_t k = 0; k < batch.size(); ++k) {
+
+            writeParameter(targetAt(batch[k].second + target.symbol), target.offset, target.kind, values[k]);
+          }
+        }
+
+        batch.clear();
+      };
+
+      size_t position = 0;
+
+      for(size_t i = 0; i < size; ++i) {
+
+        const auto production = productionAt(i);
+
+        if(production == NO_RULE) {
+
+          ++position;
+          continue;
+        }
+
+        if(!targets_[production].empty()) {
+
+          batches[production].emplace_back(sourceAt(i), position);
+
+          if(batches[production].size() == LEXPRESSION_BATCH) {
+
+            flush(production);
+          }
+        }
+
+        position += successorIds_[production].size();
+      }
+
+      for(size_t production = 0; production < batches.size(); ++production) {
+
+        if(!batches[production].empty()) {
+
+          flush(static_cast<LRuleIndex>(production));
+        }
+      }
+    }
+
+    //appends the alias table of one rule's productions, built with Vose's method
+    void buildAliases(const LAlternatives<T>& alternatives) {
+
+      constexpr const double scale = 4294967296.0;
+
+      const auto first = static_cast<LRuleIndex>(thresholds_.size());
+      const auto count = alternatives.size();
+
+      double total = 0;
+
+      for(const auto& alternative : alternatives) {
+
+        assert(alternative.weight >= 0 && "alternative weights must not be negative.");
+        total += alternative.weight;
+      }
+
+      assert(total > 0 && "a stochastic rule needs a positive total weight.");
+
+      std::vector<double> scaled;
+      std::vector<size_t> small;
+      std::vector<size_t> large;
+
+      for(size_t i = 0; i < count; ++i) {
+
+        scaled.emplace_back(alternatives[i].weight * static_cast<double>(count) / total);
+        (scaled.back() < 1.0 ? small : large).emplace_back(i);
+        thresholds_.emplace_back(static_cast<std::uint64_t>(scale));
+        aliases_.emplace_back(first + static_cast<LRuleIndex>(i));
+      }
+
+      while(!small.empty() && !large.empty()) {
+
+        const auto less = small.back();
+        const auto more = large.back();
+
+        small.pop_back();
+        large.pop_back();
+
+        thresholds_[first + less] = static_cast<std::uint64_t>(scaled[less] * scale);
+        aliases_[first + less] = first + static_cast<LRuleIndex>(more);
+
+        scaled[more] -= 1.0 - scaled[less];
+        (scaled[more] < 1.0 ? small : large).emplace_back(more);
+      }
+    }
+
+  public:
+
+    void build(const std::vector<LRule<T>>& rules, const LContextOptions<T>& options = LContextOptions<T>()) {
+
+      registry_ = LSymbolRegistry<T, Hash>();
+      productions_.clear();
+      alternativeCounts_.clear();
+      successors_.clear();
+      successors_.reserve(rules.size());
+      successorIds_.clear();
+      successorIds_.reserve(rules.size());
+      successorDataSizes_.clear();
+      thresholds_.clear();
+      aliases_.clear();
+      guards_.clear();
+      targets_.clear();
+
+      std::vector<LSymbolId> predecessors;
+
+      for(const auto& rule : rules) {
+
+        predecessors.emplace_back(registry_.intern(rule.predecessor()));
+        productions_.emplace_back(static_cast<LRuleIndex>(successors_.size()));
+        alternativeCounts_.emplace_back(static_cast<LRuleIndex>(rule.alternatives().size()));
+
+        guards_.emplace_back(rule.guard() ? rule.guard()->compile(rule.predecessor().paramSet()) : LProgram());
+
+        for(size_t alternative = 0; alternative < rule.alternatives().size(); ++alternative) {
+
+          const auto& result = rule.alternatives()[alternative].result;
+
+          successors_.emplace_back(rule.produce(LSymbol<T>(rule.predecessor()), alternative));
+          successorIds_.emplace_back();
+          successorDataSizes_.emplace_back(0);
+          targets_.emplace_back();
+
+          for(const auto& type : result) {
+
+            successorIds_.back().emplace_back(registry_.intern(type));
+            successorDataSizes_.back() += requiredDataSize(type.paramSet(), type.customParamSize());
+          }
+
+          for(const auto& expression : rule.expressions(alternative)) {
+
+            const auto offset = parameterOffset(result[expression.symbol].paramSet(), expression.kind) + expression.n * parameterSize(expression.kind);
+
+            targets_.back().push_back({expression.symbol, expression.kind, offset, expression.expression.compile(rule.predecessor().paramSet())});
+          }
+        }
+
+        buildAliases(rule.alternatives());
+      }
+
+      stochastic_ = std::any_of(rules.begin(), rules.end(), [](const auto& rule) { return rule.stochastic(); });
+      guarded_ = std::any_of(rules.begin(), rules.end(), [](const auto& rule) { return rule.guard().has_value(); });
+      parametric_ = std::any_of(targets_.begin(), targets_.end(), [](const auto& targets) { return !targets.empty(); });
+
+      contextSensitive_ = std::any_of(rules.begin(), rules.end(), [](const auto& rule) { return !rule.contextFree(); });
+
+      if(contextSensitive_) {
+
+        std::vector<std::vector<LSymbolId>> lefts;
+        std::vector<std::vector<LSymbolId>> rights;
+
+        for(const auto& rule : rules) {
+
+          lefts.emplace_back(intern(rule.left()));
+          rights.emplace_back(intern(rule.right()));
+        }
+
+        const auto push = options.push ? registry_.intern(*options.push) : NO_SYMBOL;
+        const auto pop = options.pop ? registry_.intern(*options.pop) : NO_SYMBOL;
+        const auto ignored = intern(options.ignored);
+
+        context_.build(lefts, rights, registry_.size(), push, pop, ignored);
+      }
+
+      rules_.assign(registry_.size(), NO_RULE);
+      candidates_.assign(registry_.size(), std::vector<LRuleIndex>());
+
+      //later rules overwrite earlier ones, keeping the "last match wins" behaviour of the rule list
+      for(size_t rule = 0; rule < predecessors.size(); ++rule) {
+
+        rules_[predecessors[rule]] = static_cast<LRuleIndex>(rule);
+      }
+
+      for(size_t rule = predecessors.size(); rule-- > 0;) {
+
+        auto& candidates = candidates_[predecessors[rule]];
+
+        //an unconditional rule always applies, so no earlier rule can be chosen after it
+        if(candidates.empty() || !rules[candidates.back()].contextFree() || rules[candidates.back()].guard()) {
+
+          candidates.emplace_back(static_cast<LRuleIndex>(rule));
+        }
+      }
+    }
+
+    //whether any rule has a context
+    auto contextSensitive() const noexcept -> bool {
+
+      return contextSensitive_;
+    }
+
+    //whether any rule has a guard
+    auto guarded() const noexcept -> bool {
+
+      return guarded_;
+    }
+
+    //whether rules depend on more than a symbol's type, in which case they are chosen by match rather than find
+    auto conditional() const noexcept -> bool {
+
+      return contextSensitive_ || guarded_;
+    }
+
+    //whether any rule computes parameters, which parameterize then sets after rewriting
+    auto parametric() const noexcept -> bool {
+
+      return parametric_;
+    }
+
+    //whether every symbol of a type rewrites alike, wherever it is, which lazy expansion of a system relies on
+    auto uniform() const noexcept -> bool {
+
+      return !contextSensitive_ && !stochastic_ && !guarded_ && !parametric_;
+    }
+
+    //whether any rule has several alternative results, in which case rewriting draws from a random key
+    auto stochastic() const noexcept -> bool {
+
+      return stochastic_;
+    }
+
+    //the rule chosen for every symbol of a string, taking contexts and guards into account
+    auto match(const LString<T>& lstring) const -> std::vector<LRuleIndex> {
+
+      return match(lstring.data(), lstring.data() + lstring.size());
+    }
+
+    //contexts do not reach outside [first, last)
+    auto match(const LSymbol<T>* first, const LSymbol<T>* last) const -> std::vector<LRuleIndex> {
+
+      std::vector<LRuleIndex> rules(static_cast<size_t>(last - first));
+
+      choose(rules.size(), [&](size_t i) { return registry_.find(first[i].type().representation()); }, [&](size_t i) { return first[i].parameters().data(); }, rules.data());
+
+      return rules;
+    }
+
+    auto match(const LCompactString<T, Hash>& lstring) const -> std::vector<LRuleIndex> {
+
+      std::vector<LRuleIndex> rules(lstring.size());
+
+      choose(lstring.size(), [&](size_t i) { return lstring.id(i); }, [&](size_t i) { return lstring.parameters(i); }, rules.data());
+
+      return rules;
+    }
+
+    auto registry() const noexcept -> const LSymbolRegistry<T, Hash>& {
+
+      return registry_;
+    }
+
+    //the rule for an id of this table's registry, ids interned after the table was built have none
+    auto find(LSymbolId id) const noexcept -> LRuleIndex {
+
+      return (id < rules_.size()) ? rules_[id] : NO_RULE;
+    }
+
+    auto find(const LSymbolType<T>& type) const noexcept -> LRuleIndex {
+
+      return find(registry_.find(type.representation()));
+    }
+
+    //the successor of a symbol, or nullptr if no rule applies and the symbol is kept as is
+    auto successor(const LSymbol<T>& symbol) const noexcept -> const LString<T>* {
+
+      auto rule = find(symbol.type());
+
+      return (rule == NO_RULE) ? nullptr : &successors_[productions_[rule]];
+    }
+
+    //the successor of a rule, the first alternative of a stochastic one
+    auto successor(LRuleIndex rule) const noexcept -> const LString<T>& {
+
+      return successors_[productions_[rule]];
+    }
+
+    auto successorIds(LRuleIndex rule) const noexcept -> const std::vector<LSymbolId>& {
+
+      return successorIds_[productions_[rule]];
+    }
+
+    //the exact number of symbols a range of symbols rewrites to
+    //rules, if given, holds the rule matched for each symbol of the range, otherwise rules are found by type
+    //key places the range in the random stream which stochastic rules draw from
+    auto rewrittenLength(const LSymbol<T>* first, const LSymbol<T>* last, const LRuleIndex* rules = nullptr, const LRandomKey& key = LRandomKey()) const noexcept -> size_t {
+
+      size_t length = 0;
+
+      for(size_t i = 0; first + i != last; ++i) {
+
+        auto rule = ruleAt(first, rules, i);
+
+        length += (rule == NO_RULE) ? 1 : successors_[production(rule, key, i)].size();
+      }
+
+      return length;
+    }
+
+    //rewrites a range of symbols into out, which must have room for rewrittenLength(first, last, rules, key) symbols
+    //assigning over existing symbols lets them reuse their parameter storage
+    template <typename Out>
+    auto rewrite(const LSymbol<T>* first, const LSymbol<T>* last, Out out, const LRuleIndex* rules = nullptr, const LRandomKey& key = LRandomKey()) const noexcept -> Out {
+
+      for(size_t i = 0; first + i != last; ++i) {
+
+        auto rule = ruleAt(first, rules, i);
+
+        if(rule == NO_RULE) {
+
+          *out++ = first[i];
+        }
+        else {
+
+          const auto& successor = successors_[production(rule, key, i)];
+
+          out = std::copy(successor.begin(), successor.end(), out);
+        }
+      }
+
+      return out;
+    }
+
+    //adds to record the symbols each rule rewrote and produced over a range rewritten with rules and key, and the bytes written for it
+    void tally(const LSymbol<T>* first, const LSymbol<T>* last, const LRuleIndex* rules, const LRandomKey& key, LGenerationStats& record) const {
+
+      record.ruleHits.resize(std::max(record.ruleHits.size(), productions_.size()));
+      record.ruleOutput.resize(record.ruleHits.size());
+
+      for(size_t i = 0; first + i != last; ++i) {
+
+        const auto rule = ruleAt(first, rules, i);
+
+        if(rule == NO_RULE) {
+
+          ++record.kept;
+          record.bytesMoved += sizeof(LSymbol<T>) + first[i].parameters().size();
+          continue;
+        }
+
+        const auto chosen = production(rule, key, i);
+
+        ++record.ruleHits[rule];
+        record.ruleOutput[rule] += successors_[chosen].size();
+        record.bytesMoved += successors_[chosen].size() * sizeof(LSymbol<T>) + successorDataSizes_[chosen];
+      }
+    }
+
+    //sets the parameters computed by expressions for a range already rewritten into out by rewrite(first, last, out, rules, key)
+    void parameterize(const LSymbol<T>* first, const LSymbol<T>* last, LSymbol<T>* out, const LRuleIndex* rules = nullptr, const LRandomKey& key = LRandomKey()) const {
+
+      if(!parametric_) {
+
+        return;
+      }
+
+      const auto productionAt = [&](size_t i) {
+
+        const auto rule = ruleAt(first, rules, i);
+
+        return (rule == NO_RULE) ? NO_RULE : production(rule, key, i);
+      };
+
+      evaluateExpressions(static_cast<size_t>(last - first), productionAt, [&](size_t i) { return first[i].parameters().data(); }, [&](size_t j) { return out[j].parameters().data(); });
+    }
+
+    //rewrites a compact string whose ids extend this table's registry, as those made from it do
+    //only ids are touched for parameterless strings, otherwise kept symbols copy their parameter data and produced ones are zeroed or computed
+    void rewrite(const LCompactString<T, Hash>& source, LCompactString<T, Hash>& destination, const LRandomKey& key = LRandomKey()) const {
+
+      assert(source.registry().size() >= registry_.size() && "compact string does not extend the rule table's registry.");
+
+      destination.registry_ = source.registry_; //shared rather than copied, the rewrite only writes ids this table's registry already holds
+
+      const auto matched = conditional() ? match(source) : std::vector<LRuleIndex>();
+      //the production drawn for symbol i, which indexes successors as a rule does for a deterministic table
+      const auto ruleOf = [&](size_t i) {
+
+        const auto rule = conditional() ? matched[i] : find(source.ids_[i]);
+
+        return (rule == NO_RULE) ? NO_RULE : production(rule, key, i);
+      };
+
+      size_t length = 0;
+      bool parameterized = !source.offsets_.empty();
+
+      for(size_t i = 0; i < source.ids_.size(); ++i) {
+
+        auto rule = ruleOf(i);
+
+        length += (rule == NO_RULE) ? 1 : successorIds_[rule].size();
+        parameterized = parameterized || (rule != NO_RULE && successorDataSizes_[rule] > 0);
+      }
+
+      destination.ids_.resize(length);
+      destination.arena_.clear();
+      destination.offsets_.clear();
+
+      auto* out = destination.ids_.data();
+
+      if(!parameterized) {
+
+        for(size_t i = 0; i < source.ids_.size(); ++i) {
+
+          auto rule = ruleOf(i);
+
+          if(rule == NO_RULE) {
+
+            *out++ = source.ids_[i];
+          }
+          else {
+
+            out = std::copy(successorIds_[rule].begin(), successorIds_[rule].end(), out);
+          }
+        }
+
+        return;
+      }
+
+      destination.offsets_.resize(length);
+
+      auto* offset = destination.offsets_.data();
+
+      for(size_t i = 0; i < source.ids_.size(); ++i) {
+
+        const auto id = source.ids_[i];
+        const auto rule = ruleOf(i);
+
+        if(rule == NO_RULE) {
+
+          const auto& type = source.registry_->type(id);
+          const auto* data = source.parameters(i);
+
+          *out++ = id;
+          *offset++ = destination.arena_.size();
+          destination.arena_.insert(destination.arena_.end(), data, data + requiredDataSize(type.paramSet(), type.customParamSize()));
+
+          continue;
+        }
+
+        for(auto successor : successorIds_[rule]) {
+
+          const auto& type = registry_.type(successor);
+
+          *out++ = successor;
+          *offset++ = destination.arena_.size();
+          destination.arena_.resize(destination.arena_.size() + requiredDataSize(type.paramSet(), type.customParamSize()), 0);
+        }
+      }
+
+      if(parametric_) {
+
+        evaluateExpressions(source.ids_.size(), ruleOf, [&](size_t i) { return source.parameters(i); }, [&](size_t j) { return destination.arena_.data() + destination.offsets_[j]; });
+      }
+    }
+
+    auto size() const noexcept -> size_t {
+
+      return productions_.size();
+    }
+  };
+}
+
+#endif
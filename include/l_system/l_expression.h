@@ -0,0 +1,450 @@
+#ifndef L_SYSTEM_EXPRESSION_H
+#define L_SYSTEM_EXPRESSION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "l_system/l_param.h"
+
+namespace l_system {
+
+  enum LOperation : unsigned char {
+
+    LOP_CONSTANT,
+    LOP_CHAR,
+    LOP_INT,
+    LOP_FLOAT,
+    LOP_NEGATE,
+    LOP_NOT,
+    LOP_ADD,
+    LOP_SUBTRACT,
+    LOP_MULTIPLY,
+    LOP_DIVIDE,
+    LOP_MIN,
+    LOP_MAX,
+    LOP_LESS,
+    LOP_LESS_EQUAL,
+    LOP_GREATER,
+    LOP_GREATER_EQUAL,
+    LOP_EQUAL,
+    LOP_NOT_EQUAL,
+    LOP_AND,
+    LOP_OR,
+  };
+
+  struct LInstruction {
+
+    LOperation operation;
+    LParameterDataSize operand; //a parameter's number, or its byte offset once compiled
+    float constant;
+  };
+
+  //programs are evaluated over this many symbols at a time, each instruction looping over all of them
+  constexpr const static size_t LEXPRESSION_BATCH = 256;
+
+  inline auto parameterSize(LParameter kind) noexcept -> LParameterDataSize {
+
+    switch (kind) {
+      case LCHAR:
+        return sizeof(char);
+      case LINT:
+        return sizeof(int);
+      case LFLOAT:
+        return sizeof(float);
+      default:
+        return 0;
+    }
+  }
+
+  //converts a float to an integral parameter as static_cast does, but saturating out of range values and taking NaN as 0
+  //static_cast is undefined for values it cannot represent, and results of division by zero are exactly those
+  template <typename P>
+  inline auto integralParameter(float value) noexcept -> P {
+
+    if(std::isnan(value)) {
+
+      return 0;
+    }
+
+    if(value <= static_cast<float>(std::numeric_limits<P>::min())) {
+
+      return std::numeric_limits<P>::min();
+    }
+
+    //the largest value may round up when converted, so anything from it on saturates
+    if(value >= static_cast<float>(std::numeric_limits<P>::max())) {
+
+      return std::numeric_limits<P>::max();
+    }
+
+    return static_cast<P>(value);
+  }
+
+  //stores a value as a char, int or float parameter, converting it as integralParameter does
+  inline void writeParameter(unsigned char* data, LParameterDataSize offset, LParameter kind, float value) noexcept {
+
+    switch (kind) {
+      case LCHAR: {
+        auto c = integralParameter<char>(value);
+        memcpy(data + offset, &c, sizeof(c));
+        break;
+      }
+      case LINT: {
+        auto i = integralParameter<int>(value);
+        memcpy(data + offset, &i, sizeof(i));
+        break;
+      }
+      case LFLOAT:
+        memcpy(data + offset, &value, sizeof(value));
+        break;
+      default:
+        break;
+    }
+  }
+
+  //an expression compiled against one parameter layout, its loads read at fixed byte offsets
+  //it runs over a batch of symbols one instruction at a time, so every instruction is a plain loop the compiler can vectorize
+  class LProgram {
+
+    std::vector<LInstruction> code_;
+    size_t depth_ = 0; //the most values on the stack at once
+
+    template <typename F>
+    static void apply(float* a, const float* b, size_t count, F&& f) noexcept {
+
+      for(size_t k = 0; k < count; ++k) {
+
+        a[k] = f(a[k], b[k]);
+      }
+    }
+
+    template <typename P>
+    static void load(float* column, const unsigned char* const* sources, size_t count, LParameterDataSize offset) noexcept {
+
+      for(size_t k = 0; k < count; ++k) {
+
+        column[k] = static_cast<float>(readParameter<P>(sources[k], offset));
+      }
+    }
+
+  public:
+
+    LProgram() = default;
+
+    LProgram(std::vector<LInstruction> code, size_t depth) : code_(std::move(code)), depth_(depth) {}
+
+    auto empty() const noexcept -> bool {
+
+      return code_.empty();
+    }
+
+    //evaluates for count symbols, at most LEXPRESSION_BATCH, of which sources[k] is the parameter data of symbol k
+    //stack is scratch space, kept by the caller so that batches do not allocate
+    void evaluate(const unsigned char* const* sources, size_t count, float* result, std::vector<float>& stack) const noexcept {
+
+      assert(count <= LEXPRESSION_BATCH && "batch too large.");
+
+      //an empty program has nothing to leave on the stack, and evaluates to 0
+      if(code_.empty()) {
+
+        std::fill(result, result + count, 0.0f);
+        return;
+      }
+
+      stack.resize(std::max<size_t>(depth_, 1) * LEXPRESSION_BATCH);
+
+      const auto column = [&](size_t n) { return stack.data() + n * LEXPRESSION_BATCH; };
+      size_t top = 0;
+
+      for(const auto& instruction : code_) {
+
+        if(instruction.operation <= LOP_FLOAT) {
+
+          auto* pushed = column(top++);
+
+          switch (instruction.operation) {
+            case LOP_CHAR:
+              load<char>(pushed, sources, count, instruction.operand);
+              break;
+            case LOP_INT:
+              load<int>(pushed, sources, count, instruction.operand);
+              break;
+            case LOP_FLOAT:
+              load<float>(pushed, sources, count, instruction.operand);
+              break;
+            default:
+              std::fill(pushed, pushed + count, instruction.constant);
+              break;
+          }
+
+          continue;
+        }
+
+        //binary operations pop their right operand, and both kinds overwrite the top value
+        if(instruction.operation >= LOP_ADD) {
+
+          --top;
+        }
+
+        auto* a = column(top - 1);
+        const auto* b = column(top);
+
+        switch (instruction.operation) {
+          case LOP_NEGATE:
+            apply(a, a, count, [](float x, float) { return -x; });
+            break;
+          case LOP_NOT:
+            apply(a, a, count, [](float x, float) { return (x == 0.0f) ? 1.0f : 0.0f; });
+            break;
+          case LOP_ADD:
+            apply(a, b, count, [](float x, float y) { return x + y; });
+            break;
+          case LOP_SUBTRACT:
+            apply(a, b, count, [](float x, float y) { return x - y; });
+            break;
+          case LOP_MULTIPLY:
+            apply(a, b, count, [](float x, float y) { return x * y; });
+            break;
+          case LOP_DIVIDE:
+            apply(a, b, count, [](float x, float y) { return x / y; });
+            break;
+          case LOP_MIN:
+            apply(a, b, count, [](float x, float y) { return (y < x) ? y : x; });
+            break;
+          case LOP_MAX:
+            apply(a, b, count, [](float x, float y) { return (x < y) ? y : x; });
+            break;
+          case LOP_LESS:
+            apply(a, b, count, [](float x, float y) { return (x < y) ? 1.0f : 0.0f; });
+            break;
+          case LOP_LESS_EQUAL:
+            apply(a, b, count, [](float x, float y) { return (x <= y) ? 1.0f : 0.0f; });
+            break;
+          case LOP_GREATER:
+            apply(a, b, count, [](float x, float y) { return (x > y) ? 1.0f : 0.0f; });
+            break;
+          case LOP_GREATER_EQUAL:
+            apply(a, b, count, [](float x, float y) { return (x >= y) ? 1.0f : 0.0f; });
+            break;
+          case LOP_EQUAL:
+            apply(a, b, count, [](float x, float y) { return (x == y) ? 1.0f : 0.0f; });
+            break;
+          case LOP_NOT_EQUAL:
+            apply(a, b, count, [](float x, float y) { return (x != y) ? 1.0f : 0.0f; });
+            break;
+          case LOP_AND:
+            apply(a, b, count, [](float x, float y) { return (x != 0.0f && y != 0.0f) ? 1.0f : 0.0f; });
+            break;
+          case LOP_OR:
+            apply(a, b, count, [](float x, float y) { return (x != 0.0f || y != 0.0f) ? 1.0f : 0.0f; });
+            break;
+          default:
+            break;
+        }
+      }
+
+      std::copy(column(0), column(0) + count, result);
+    }
+  };
+
+  //an arithmetic expression over the char, int and float parameters of a symbol, built with the usual operators
+  //it is kept as postfix code, so combining expressions appends their code rather than building a tree
+  //all arithmetic is in float, ints are exact up to 2^24, and comparisons and logic give 1 for true and 0 for false
+  class LExpression {
+
+    std::vector<LInstruction> code_;
+
+  public:
+
+    LExpression(float constant = 0.0f) : code_({{LOP_CONSTANT, 0, constant}}) {}
+
+    //an expression from postfix code, as code() gives it
+    explicit LExpression(std::vector<LInstruction> code) : code_(std::move(code)) {}
+
+    //parameter n of a kind of the symbol being rewritten
+    static auto parameter(LParameter kind, LParameterCount n) noexcept -> LExpression {
+
+      assert((kind == LCHAR || kind == LINT || kind == LFLOAT) && "expressions only read char, int and float parameters.");
+
+      LExpression result;
+      result.code_ = {{(kind == LCHAR) ? LOP_CHAR : (kind == LINT) ? LOP_INT : LOP_FLOAT, n, 0.0f}};
+
+      return result;
+    }
+
+    static auto unary(const LExpression& a, LOperation operation) -> LExpression {
+
+      LExpression result(a);
+      result.code_.push_back({operation, 0, 0.0f});
+
+      return result;
+    }
+
+    static auto binary(const LExpression& a, const LExpression& b, LOperation operation) -> LExpression {
+
+      LExpression result(a);
+      result.code_.insert(result.code_.end(), b.code_.begin(), b.code_.end());
+      result.code_.push_back({operation, 0, 0.0f});
+
+      return result;
+    }
+
+    auto code() const noexcept -> const std::vector<LInstruction>& {
+
+      return code_;
+    }
+
+    //resolves the parameter loads against a parameter layout
+    auto compile(LParameterSet set) const -> LProgram {
+
+      std::vector<LInstruction> code(code_);
+      size_t depth = 0;
+      size_t top = 0;
+
+      for(auto& instruction : code) {
+
+        switch (instruction.operation) {
+          case LOP_CHAR:
+            assert(instruction.operand < parameterCount(set, LCHAR) && "out of bounds parameter access.");
+            instruction.operand = parameterOffset(set, LCHAR) + instruction.operand * sizeof(char);
+            break;
+          case LOP_INT:
+            assert(instruction.operand < parameterCount(set, LINT) && "out of bounds parameter access.");
+            instruction.operand = parameterOffset(set, LINT) + instruction.operand * sizeof(int);
+            break;
+          case LOP_FLOAT:
+            assert(instruction.operand < parameterCount(set, LFLOAT) && "out of bounds parameter access.");
+            instruction.operand = parameterOffset(set, LFLOAT) + instruction.operand * sizeof(float);
+            break;
+          default:
+            break;
+        }
+
+        if(instruction.operation <= LOP_FLOAT) {
+
+          depth = std::max(depth, ++top);
+        }
+        else if(instruction.operation >= LOP_ADD) {
+
+          --top;
+        }
+      }
+
+      return LProgram(std::move(code), depth);
+    }
+
+    //the value for one symbol's parameter data, for use outside of batches
+    auto evaluate(const unsigned char* data, LParameterSet set) const -> float {
+
+      std::vector<float> stack;
+      float result = 0.0f;
+
+      compile(set).evaluate(&data, 1, &result, stack);
+
+      return result;
+    }
+
+    auto representation() const -> std::string {
+
+      std::vector<std::string> stack;
+
+      for(const auto& instruction : code_) {
+
+        std::ostringstream stream;
+
+        if(instruction.operation == LOP_CONSTANT) {
+
+          stream << instruction.constant;
+        }
+        else if(instruction.operation <= LOP_FLOAT) {
+
+          stream << "?cif"[instruction.operation] << instruction.operand;
+        }
+        else if(instruction.operation <= LOP_NOT) {
+
+          stream << ((instruction.operation == LOP_NEGATE) ? "-" : "!") << stack.back();
+          stack.pop_back();
+        }
+        else {
+
+          const auto b = stack.back();
+          stack.pop_back();
+          const auto a = stack.back();
+          stack.pop_back();
+
+          constexpr const char* symbols[] = {"+", "-", "*", "/", "min", "max", "<", "<=", ">", ">=", "==", "!=", "&&", "||"};
+          const auto* symbol = symbols[instruction.operation - LOP_ADD];
+
+          if(instruction.operation == LOP_MIN || instruction.operation == LOP_MAX) {
+
+            stream << symbol << '(' << a << ',' << b << ')';
+          }
+          else {
+
+            stream << '(' << a << symbol << b << ')';
+          }
+        }
+
+        stack.emplace_back(stream.str());
+      }
+
+      return stack.back();
+    }
+  };
+
+  inline auto charParam(LParameterCount n) noexcept -> LExpression {
+
+    return LExpression::parameter(LCHAR, n);
+  }
+
+  inline auto intParam(LParameterCount n) noexcept -> LExpression {
+
+    return LExpression::parameter(LINT, n);
+  }
+
+  inline auto floatParam(LParameterCount n) noexcept -> LExpression {
+
+    return LExpression::parameter(LFLOAT, n);
+  }
+
+  inline auto operator-(const LExpression& a) -> LExpression { return LExpression::unary(a, LOP_NEGATE); }
+  inline auto operator!(const LExpression& a) -> LExpression { return LExpression::unary(a, LOP_NOT); }
+  inline auto operator+(const LExpression& a, const LExpression& b) -> LExpression { return LExpression::binary(a, b, LOP_ADD); }
+  inline auto operator-(const LExpression& a, const LExpression& b) -> LExpression { return LExpression::binary(a, b, LOP_SUBTRACT); }
+  inline auto operator*(const LExpression& a, const LExpression& b) -> LExpression { return LExpression::binary(a, b, LOP_MULTIPLY); }
+  inline auto operator/(const LExpression& a, const LExpression& b) -> LExpression { return LExpression::binary(a, b, LOP_DIVIDE); }
+  inline auto operator<(const LExpression& a, const LExpression& b) -> LExpression { return LExpression::binary(a, b, LOP_LESS); }
+  inline auto operator<=(const LExpression& a, const LExpression& b) -> LExpression { return LExpression::binary(a, b, LOP_LESS_EQUAL); }
+  inline auto operator>(const LExpression& a, const LExpression& b) -> LExpression { return LExpression::binary(a, b, LOP_GREATER); }
+  inline auto operator>=(const LExpression& a, const LExpression& b) -> LExpression { return LExpression::binary(a, b, LOP_GREATER_EQUAL); }
+  inline auto operator==(const LExpression& a, const LExpression& b) -> LExpression { return LExpression::binary(a, b, LOP_EQUAL); }
+  inline auto operator!=(const LExpression& a, const LExpression& b) -> LExpression { return LExpression::binary(a, b, LOP_NOT_EQUAL); }
+  inline auto operator&&(const LExpression& a, const LExpression& b) -> LExpression { return LExpression::binary(a, b, LOP_AND); }
+  inline auto operator||(const LExpression& a, const LExpression& b) -> LExpression { return LExpression::binary(a, b, LOP_OR); }
+
+  inline auto minimum(const LExpression& a, const LExpression& b) -> LExpression {
+
+    return LExpression::binary(a, b, LOP_MIN);
+  }
+
+  inline auto maximum(const LExpression& a, const LExpression& b) -> LExpression {
+
+    return LExpression::binary(a, b, LOP_MAX);
+  }
+
+  //sets parameter n of a kind of one symbol of a rule's result
+  struct LParameterExpression {
+
+    size_t symbol;
+    LParameter kind;
+    LParameterCount n;
+    LExpression expression;
+  };
+}
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef L_SYSTEM_FORMAT_H
+#define L_SYSTEM_FORMAT_H
+
+#include <charconv>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#include "l_system/l_param.h"
+
+namespace l_system {
+
+  //representations an ostream writes as a single character
+  template <typename T>
+  constexpr const static bool LCHARACTER_REPRESENTATION = std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>;
+
+  //representations std::to_chars writes as an ostream does, any other representation is formatted through a stream
+  template <typename T>
+  constexpr const static bool LNUMERIC_REPRESENTATION = std::is_arithmetic_v<T> && !LCHARACTER_REPRESENTATION<T>
+    && !std::is_same_v<T, bool> && !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>;
+
+  //room for a character or number written by formatRepresentation
+  constexpr const static size_t LFORMAT_NUMBER_SIZE = 64;
+
+  //the significant digits of floats, as an ostream's default precision
+  constexpr const static int LFORMAT_PRECISION = 6;
+
+  //writes a character or numeric representation into out, which must have room for LFORMAT_NUMBER_SIZE characters
+  template <typename T>
+  auto formatRepresentation(char* out, T representation) noexcept -> char* {
+
+    static_assert(LCHARACTER_REPRESENTATION<T> || LNUMERIC_REPRESENTATION<T>, "only characters and numbers are formatted directly.");
+
+    if constexpr (LCHARACTER_REPRESENTATION<T>) {
+
+      *out = static_cast<char>(representation);
+
+      return out + 1;
+    }
+    else if constexpr (std::is_floating_point_v<T>) {
+
+      return std::to_chars(out, out + LFORMAT_NUMBER_SIZE, representation, std::chars_format::general, LFORMAT_PRECISION).ptr;
+    }
+    else {
+
+      return std::to_chars(out, out + LFORMAT_NUMBER_SIZE, representation).ptr;
+    }
+  }
+
+  //appends the text an ostream gives a representation
+  template <typename T>
+  void appendRepresentation(std::string& out, const T& representation) {
+
+    if constexpr (LCHARACTER_REPRESENTATION<T>) {
+
+      out.push_back(static_cast<char>(representation));
+    }
+    else if constexpr (LNUMERIC_REPRESENTATION<T>) {
+
+      char buffer[LFORMAT_NUMBER_SIZE];
+
+      out.append(buffer, formatRepresentation(buffer, representation));
+    }
+    else {
+
+      std::ostringstream stream;
+
+      stream << representation;
+      out += stream.str();
+    }
+  }
+
+  //the most characters formatParameters writes for a parameter set
+  inline auto formattedParametersSize(LParameterSet set, LParameterCustomSize customSize) noexcept -> size_t {
+
+    return 2 + (2 * static_cast<size_t>(parameterCount(set, LCHAR))) //"c "
+      + (12 * static_cast<size_t>(parameterCount(set, LINT))) //"-2147483648 "
+      + (16 * static_cast<size_t>(parameterCount(set, LFLOAT))) //"-1.17549e-38 "
+      + ((2 * static_cast<size_t>(customSize) + 1) * parameterCount(set, LCUSTOM)); //two hex digits per byte
+  }
+
+  //writes raw parameter data as representSymbol does, into out which must have room for formattedParametersSize characters
+  inline auto formatParameters(char* out, LParameterSet set, LParameterCustomSize customSize, const unsigned char* data) noexcept -> char* {
+
+    *out++ = '(';
+
+    for(LParameterCount i = 0; i < parameterCount(set, LCHAR); ++i) {
+
+      *out++ = readParameter<char>(data, parameterOffset(set, LCHAR) + i);
+      *out++ = ' ';
+    }
+    for(LParameterCount i = 0; i < parameterCount(set, LINT); ++i) {
+
+      out = std::to_chars(out, out + 11, readParameter<int>(data, parameterOffset(set, LINT) + i * sizeof(int))).ptr;
+      *out++ = ' ';
+    }
+    for(LParameterCount i = 0; i < parameterCount(set, LFLOAT); ++i) {
+
+      out = std::to_chars(out, out + 15, readParameter<float>(data, parameterOffset(set, LFLOAT) + i * sizeof(float)), std::chars_format::general, LFORMAT_PRECISION).ptr;
+      *out++ = ' ';
+    }
+    for(LParameterCount i = 0; i < parameterCount(set, LCUSTOM); ++i) {
+
+      const auto* custom = data + parameterOffset(set, LCUSTOM) + static_cast<size_t>(i * customSize);
+
+      //unpadded hex, as represent(data, false) writes it
+      for(LParameterCustomSize byte = 0; byte < customSize; ++byte) {
+
+        out = std::to_chars(out, out + 2, static_cast<unsigned int>(custom[byte]), 16).ptr;
+      }
+
+      *out++ = ' ';
+    }
+
+    *out++ = ')';
+
+    return out;
+  }
+
+  //appends raw parameter data as representSymbol writes it
+  inline void appendParameters(std::string& out, LParameterSet set, LParameterCustomSize customSize, const unsigned char* data) {
+
+    const auto size = out.size();
+
+    out.resize(size + formattedParametersSize(set, customSize));
+    out.resize(static_cast<size_t>(formatParameters(out.data() + size, set, customSize, data) - out.data()));
+  }
+}
+
+#endif
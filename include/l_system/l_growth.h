@@ -0,0 +1,434 @@
+#ifndef L_SYSTEM_GROWTH_H
+#define L_SYSTEM_GROWTH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "l_system/l_system.h"
+
+namespace l_system {
+
+  using LCount = std::uint64_t;
+
+  //counts saturate here, a saturated count means the true value does not fit in an LCount
+  constexpr const static LCount LCOUNT_OVERFLOW = std::numeric_limits<LCount>::max();
+
+  constexpr inline auto saturatingAdd(LCount a, LCount b) noexcept -> LCount {
+
+    return (a > LCOUNT_OVERFLOW - b) ? LCOUNT_OVERFLOW : a + b;
+  }
+
+  constexpr inline auto saturatingMultiply(LCount a, LCount b) noexcept -> LCount {
+
+    return (a != 0 && b > LCOUNT_OVERFLOW / a) ? LCOUNT_OVERFLOW : a * b;
+  }
+
+  //the size of a buffer of T holding count elements and slack more, for engines sizing their buffers from a saturating count
+  //throws std::length_error if a vector can not hold it, which a saturated count never can, rather than letting the addition wrap
+  template <typename T>
+  auto bufferSize(LCount count, size_t slack) -> size_t {
+
+    if(count >= std::vector<T>().max_size() - slack) {
+
+      throw std::length_error("the generation does not fit in memory.");
+    }
+
+    return count + slack;
+  }
+
+  //exact analysis of the growth of a deterministic context-free system without guards, without generating it
+  //symbol counts of generation n are the axiom's counts times the n-th power of the rule successor count matrix
+  //the analyzer copies the system's axiom and rules, later changes to the system are not reflected
+  //symbolAt, slice and saturatedLength extend a table of expansion lengths the first time they reach a depth,
+  //so an analyzer must not be queried from several threads at once, except below a depth saturatedLength has already reached
+  template <typename T, typename Hash = std::hash<T>>
+  class LGrowth {
+
+    using Matrix = std::vector<std::vector<LCount>>;
+
+    std::vector<LSymbolType<T>> types_; //every symbol type of the system, in getAllSymbolTypes order
+    LString<T> axiom_;
+    LRuleTable<T, Hash> table_;
+    std::vector<size_t> axiomTypes_; //type index of each axiom symbol
+    std::vector<LRuleIndex> rules_; //type index -> the rule rewriting it, or NO_RULE
+    std::vector<std::vector<size_t>> successorTypes_; //type index -> type indices of its successor
+    Matrix growth_; //growth_[i][j] is the number of type j symbols produced by one type i symbol
+    mutable std::vector<std::vector<LCount>> lengths_; //lengths_[d][i] is the length a type i symbol expands to in d generations, written by const queries
+
+    auto typeIndex(const LSymbolType<T>& type) const noexcept -> size_t {
+
+      return static_cast<size_t>(std::lower_bound(types_.begin(), types_.end(), type) - types_.begin());
+    }
+
+    static auto multiply(const Matrix& a, const Matrix& b) noexcept -> Matrix {
+
+      Matrix result(a.size(), std::vector<LCount>(a.size(), 0));
+
+      for(size_t i = 0; i < a.size(); ++i) {
+
+        for(size_t k = 0; k < a.size(); ++k) {
+
+          if(a[i][k] == 0) {
+
+            continue;
+          }
+
+          for(size_t j = 0; j < a.size(); ++j) {
+
+            result[i][j] = saturatingAdd(result[i][j], saturatingMultiply(a[i][k], b[k][j]));
+          }
+        }
+      }
+
+      return result;
+    }
+
+    static auto multiply(const std::vector<LCount>& v, const Matrix& m) noexcept -> std::vector<LCount> {
+
+      std::vector<LCount> result(v.size(), 0);
+
+      for(size_t k = 0; k < v.size(); ++k) {
+
+        if(v[k] == 0) {
+
+          continue;
+        }
+
+        for(size_t j = 0; j < v.size(); ++j) {
+
+          result[j] = saturatingAdd(result[j], saturatingMultiply(v[k], m[k][j]));
+        }
+      }
+
+      return result;
+    }
+
+    //the per type expansion lengths of depth 0 to generations, extended on demand by a row per generation, which may throw bad_alloc for a runaway depth
+    auto lengths(int generations) const -> const std::vector<std::vector<LCount>>& {
+
+      if(lengths_.empty()) {
+
+        lengths_.emplace_back(types_.size(), 1);
+      }
+
+      while(lengths_.size() <= static_cast<size_t>(generations)) {
+
+        const auto& previous = lengths_.back();
+        std::vector<LCount> next(types_.size(), 1);
+
+        for(size_t i = 0; i < types_.size(); ++i) {
+
+          if(rules_[i] == NO_RULE) {
+
+            continue;
+          }
+
+          next[i] = 0;
+
+          for(auto type : successorTypes_[i]) {
+
+            next[i] = saturatingAdd(next[i], previous[type]);
+          }
+        }
+
+        lengths_.emplace_back(std::move(next));
+      }
+
+      return lengths_;
+    }
+
+    LGrowth(const LSystem<T, Hash>& system) : axiom_(system.axiom()), table_(system.compiled()) {
+
+      const auto types = system.getAllSymbolTypes();
+      types_.assign(types.begin(), types.end());
+
+      rules_.assign(types_.size(), NO_RULE);
+      successorTypes_.resize(types_.size());
+      growth_.assign(types_.size(), std::vector<LCount>(types_.size(), 0));
+
+      for(const auto& symbol : axiom_) {
+
+        axiomTypes_.emplace_back(typeIndex(symbol.type()));
+      }
+
+      for(size_t i = 0; i < types_.size(); ++i) {
+
+        rules_[i] = table_.find(types_[i]);
+
+        if(rules_[i] == NO_RULE) {
+
+          growth_[i][i] = 1;
+          continue;
+        }
+
+        for(const auto& symbol : table_.successor(rules_[i])) {
+
+          auto type = typeIndex(symbol.type());
+
+          successorTypes_[i].emplace_back(type);
+          ++growth_[i][type];
+        }
+      }
+    }
+
+  public:
+
+    //the analyzer of a system, or nothing if its rules are not uniform, that is deterministic context-free rules without guards or parameter expressions
+    static auto analyze(const LSystem<T, Hash>& system) -> std::optional<LGrowth> {
+
+      if(!system.compiled().uniform()) {
+
+        return std::nullopt;
+      }
+
+      return LGrowth(system);
+    }
+
+    auto types() const noexcept -> const std::vector<LSymbolType<T>>& {
+
+      return types_;
+    }
+
+    //the number of symbols of each type in a generation, in types() order, or nothing if a count overflows
+    //as with generate, a negative number of generations is the axiom, and so is it for every query below
+    auto histogram(int generations) const noexcept -> std::optional<std::vector<LCount>> {
+
+      std::vector<LCount> counts(types_.size(), 0);
+
+      for(auto type : axiomTypes_) {
+
+        ++counts[type];
+      }
+
+      auto power = growth_;
+
+      for(auto n = static_cast<unsigned int>(std::max(0, generations)); n > 0; n >>= 1) {
+
+        if(n & 1) {
+
+          counts = multiply(counts, power);
+        }
+
+        if(n > 1) {
+
+          power = multiply(power, power);
+        }
+      }
+
+      for(auto count : counts) {
+
+        if(count == LCOUNT_OVERFLOW) {
+
+          return std::nullopt;
+        }
+      }
+
+      return counts;
+    }
+
+    //the length of a generation, or nothing if it overflows
+    auto length(int generations) const noexcept -> std::optional<LCount> {
+
+      auto counts = histogram(generations);
+
+      if(!counts) {
+
+        return std::nullopt;
+      }
+
+      LCount total = 0;
+
+      for(auto count : *counts) {
+
+        total = saturatingAdd(total, count);
+      }
+
+      return (total == LCOUNT_OVERFLOW) ? std::nullopt : std::optional<LCount>(total);
+    }
+
+    //the symbol at an index of a generation, found by descending through the derivation, or nothing if out of range
+    auto symbolAt(int generations, LCount index) const -> std::optional<LSymbol<T>> {
+
+      const iterator it(*this, generations, index);
+
+      return it.exhausted() ? std::nullopt : std::optional<LSymbol<T>>(*it);
+    }
+
+    //the symbols in [begin, end) of a generation, skipping every subtree outside of the range, clamped to the generation's length
+    auto slice(int generations, LCount begin, LCount end) const -> LString<T> {
+
+      LString<T> result;
+
+      for(iterator it(*this, generations, begin); !it.exhausted() && it.index() < end; ++it) {
+
+        result.emplace_back(*it);
+      }
+
+      return result;
+    }
+
+    //the length of a generation, saturated rather than checked, from the per type expansion lengths
+    //these are kept, so iterating the generation afterwards extends nothing and may be done from several threads
+    auto saturatedLength(int generations) const -> LCount {
+
+      generations = std::max(0, generations);
+
+      const auto& length = lengths(generations)[static_cast<size_t>(generations)];
+      LCount total = 0;
+
+      for(auto type : axiomTypes_) {
+
+        total = saturatingAdd(total, length[type]);
+      }
+
+      return total;
+    }
+
+    //walks a generation from an index, descending straight to it through the derivation without producing the symbols before it
+    //expanding a symbol type for d generations always gives the same string, so only the per type expansion lengths are needed
+    class iterator {
+
+      struct Frame {
+
+        const LSymbol<T>* symbols;
+        const size_t* types;
+        size_t size;
+        size_t position;
+        int remaining; //the generations left to expand the symbols of this frame
+      };
+
+      const LGrowth* growth_ = nullptr;
+      LCount index_ = 0;
+      std::vector<Frame> stack_;
+
+      //descends from the current position, skipping whole subtrees until skip is used up, then to the symbol it rests on
+      void settle(LCount skip) noexcept {
+
+        while(!stack_.empty()) {
+
+          auto& top = stack_.back();
+
+          if(top.position == top.size) {
+
+            stack_.pop_back();
+
+            if(!stack_.empty()) {
+
+              ++stack_.back().position;
+            }
+
+            continue;
+          }
+
+          const auto type = top.types[top.position];
+          const auto expanded = growth_->lengths_[static_cast<size_t>(top.remaining)][type];
+
+          if(skip >= expanded) {
+
+            skip -= expanded;
+            ++top.position;
+            continue;
+          }
+
+          const auto rule = growth_->rules_[type];
+
+          if(top.remaining == 0 || rule == NO_RULE) {
+
+            return;
+          }
+
+          const auto& successor = growth_->table_.successor(rule);
+
+          stack_.push_back({successor.data(), growth_->successorTypes_[type].data(), successor.size(), 0, top.remaining - 1});
+        }
+      }
+
+    public:
+
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = LSymbol<T>;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const LSymbol<T>*;
+      using reference = const LSymbol<T>&;
+
+      iterator() = default;
+
+      iterator(const LGrowth& growth, int generations, LCount index) : growth_(&growth), index_(index) {
+
+        generations = std::max(0, generations);
+        growth.lengths(generations);
+
+        stack_.reserve(static_cast<size_t>(generations) + 1);
+        stack_.push_back({growth.axiom_.data(), growth.axiomTypes_.data(), growth.axiom_.size(), 0, generations});
+
+        settle(index);
+      }
+
+      //an iterator which only marks a position, used as the end of a range
+      static auto sentinel(LCount index) noexcept -> iterator {
+
+        iterator result;
+        result.index_ = index;
+
+        return result;
+      }
+
+      auto index() const noexcept -> LCount {
+
+        return index_;
+      }
+
+      //whether the iterator is past the last symbol of its generation
+      auto exhausted() const noexcept -> bool {
+
+        return stack_.empty();
+      }
+
+      auto operator*() const noexcept -> reference {
+
+        return stack_.back().symbols[stack_.back().position];
+      }
+
+      auto operator->() const noexcept -> pointer {
+
+        return &**this;
+      }
+
+      auto operator++() noexcept -> iterator& {
+
+        ++stack_.back().position;
+        ++index_;
+        settle(0);
+
+        return *this;
+      }
+
+      auto operator++(int) noexcept -> iterator {
+
+        auto previous = *this;
+        ++*this;
+
+        return previous;
+      }
+
+      //iterators over the same generation compare by position, so an end iterator needs no stack
+      bool operator==(const iterator& other) const noexcept {
+
+        return index_ == other.index_;
+      }
+
+      bool operator!=(const iterator& other) const noexcept {
+
+        return !(*this == other);
+      }
+    };
+  };
+}
+
+#endif
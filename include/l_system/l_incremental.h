@@ -0,0 +1,498 @@
+#ifndef L_SYSTEM_INCREMENTAL_H
+#define L_SYSTEM_INCREMENTAL_H
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "l_system/l_system.h"
+
+namespace l_system {
+
+  //what an edit does to the symbols of a type
+  enum LReach : unsigned char {
+
+    LREACH_NONE, //never rewrites into an edited type
+    LREACH_REACHES, //may rewrite into an edited type in some later generation
+    LREACH_EDITED //its rules were edited
+  };
+
+  //a run of values moving within a vector, changes is set if its values change even where they stay
+  struct LShift {
+
+    size_t source;
+    size_t target;
+    size_t size;
+    bool changes;
+  };
+
+  //inert runs shorter than this are merged into the clean runs around them, which are scanned again each generation instead
+  constexpr const static size_t LINERT_RUN = 64;
+
+  //a run of consecutive symbols of a generation being derived again
+  //a clean run equals the run of the generation before the edit starting at old, so its successors can be taken from the old next generation
+  //an inert clean run holds no symbol which can ever rewrite into an edited type, so its descendants stay clean in every later generation
+  struct LRun {
+
+    size_t begin; //the run's first symbol
+    size_t size;
+    bool clean;
+    bool inert;
+    size_t old; //the run's first symbol before the edit, for clean runs
+  };
+
+  //keeps every generation of a system up to a depth, and derives them again after an edit by rewriting only what the edit affects
+  //each generation keeps a span map, where each of its symbols rewrote to in the next, so unaffected runs are spliced from the old generations
+  //whether a symbol is affected comes from a reachability graph over the system's symbol types, which types can rewrite into an edited one
+  //deterministic context-free rules, guarded or parametric, are derived incrementally, stochastic and context sensitive ones fall back to deriving everything
+  //memory is that of every generation plus a size_t per symbol for the span maps
+  template <typename T, typename Hash = std::hash<T>>
+  class LIncremental {
+
+    LSystem<T, Hash> system_;
+    std::vector<LString<T>> generations_; //generations 0 to the deepest kept
+    std::vector<std::vector<size_t>> spans_; //spans_[g][i] is the first symbol of generation g + 1 which symbol i of generation g rewrote to, ending in the size of generation g + 1
+    size_t rewritten_ = 0; //symbols rewritten by the last derivation, the others were spliced
+
+    //adds a run after the last one, merging the two if the first continues into the second
+    static void append(std::vector<LRun>& runs, const LRun& run) {
+
+      if(run.size == 0) {
+
+        return;
+      }
+
+      if(!runs.empty()) {
+
+        auto& last = runs.back();
+
+        if(last.clean == run.clean && last.inert == run.inert && (!run.clean || last.old + last.size == run.old)) {
+
+          last.size += run.size;
+          return;
+        }
+      }
+
+      runs.push_back(run);
+    }
+
+    //appends a run as append does, also merging clean runs which continue each other where one is inert but short, so that the merged run is scanned again
+    static void coalesce(std::vector<LRun>& runs, const LRun& run) {
+
+      const auto shortInert = [](const LRun& r) { return r.inert && r.size < LINERT_RUN; };
+
+      if(!runs.empty() && run.size != 0) {
+
+        auto& last = runs.back();
+
+        if(last.clean && run.clean && last.inert != run.inert && last.old + last.size == run.old && (shortInert(last) || shortInert(run))) {
+
+          last.size += run.size;
+          last.inert = false;
+          return;
+        }
+      }
+
+      append(runs, run);
+    }
+
+    static auto sameSymbol(const LSymbol<T>& a, const LSymbol<T>& b) noexcept -> bool {
+
+      const auto& first = a.parameters();
+      const auto& second = b.parameters();
+
+      return a.type() == b.type() && first.set() == second.set() && first.size() == second.size()
+        && (first.size() == 0 || memcmp(first.data(), second.data(), first.size()) == 0);
+    }
+
+    //what an edit does to symbols of each type, by a reachability graph over every symbol type of the system and its rules
+    //a type reaches an edited type if some chain of its rules can produce one, types missing from the result are unaffected
+    auto reaching(const std::unordered_set<T, Hash>& edited) const -> std::unordered_map<T, LReach, Hash> {
+
+      std::map<LSymbolType<T>, std::vector<LSymbolType<T>>> producers; //type -> the types whose rules produce it
+
+      for(const auto& type : system_.getAllSymbolTypes()) {
+
+        producers[type];
+      }
+
+      for(const auto& rule : system_.rules()) {
+
+        for(const auto& alternative : rule.alternatives()) {
+
+          for(const auto& type : alternative.result) {
+
+            producers[type].emplace_back(rule.predecessor());
+          }
+        }
+      }
+
+      std::unordered_map<T, LReach, Hash> result;
+      std::vector<T> pending(edited.begin(), edited.end());
+
+      for(const auto& type : edited) {
+
+        result[type] = LREACH_EDITED;
+      }
+
+      while(!pending.empty()) {
+
+        const auto type = pending.back();
+        pending.pop_back();
+
+        for(const auto& producer : producers[LSymbolType<T>(type)]) {
+
+          if(result.emplace(producer.representation(), LREACH_REACHES).second) {
+
+            pending.emplace_back(producer.representation());
+          }
+        }
+      }
+
+      return result;
+    }
+
+    auto key(int generation, size_t position) const noexcept -> LRandomKey {
+
+      return {system_.seed(), static_cast<std::uint64_t>(generation), position};
+    }
+
+    //appends the rules matched for a run about to be rewritten to rules, and the length each of its symbols rewrites to to lengths, returning the run's length
+    auto measure(const LRuleTable<T, Hash>& table, const LString<T>& current, const LRun& run, int generation, std::vector<LRuleIndex>& rules, std::vector<size_t>& lengths) const -> size_t {
+
+      const auto* first = current.data() + run.begin;
+      const auto matched = rules.size();
+      size_t length = 0;
+
+      if(table.conditional()) {
+
+        const auto found = table.match(first, first + run.size);
+
+        rules.insert(rules.end(), found.begin(), found.end());
+      }
+
+      for(size_t i = 0; i < run.size; ++i) {
+
+        lengths.emplace_back(table.rewrittenLength(first + i, first + i + 1, table.conditional() ? rules.data() + matched + i : nullptr, key(generation, run.begin + i)));
+        length += lengths.back();
+      }
+
+      return length;
+    }
+
+    //moves runs of values within values, each from its source to its target, setting each moved value to place(n, value) for run n
+    //runs keep their order and do not overlap, so moving those going left front to back, then those going right back to front, never overwrites one still to be moved
+    //a run which stays is only touched if its values change
+    template <typename Value, typename F>
+    static void shift(std::vector<Value>& values, const std::vector<LShift>& shifts, F&& place) {
+
+      for(size_t n = 0; n < shifts.size(); ++n) {
+
+        const auto& run = shifts[n];
+
+        if(run.target < run.source || (run.target == run.source && run.changes)) {
+
+          for(size_t i = 0; i < run.size; ++i) {
+
+            values[run.target + i] = place(n, std::move(values[run.source + i]));
+          }
+        }
+      }
+
+      for(size_t n = shifts.size(); n-- > 0;) {
+
+        const auto& run = shifts[n];
+
+        if(run.target > run.source) {
+
+          for(size_t i = run.size; i-- > 0;) {
+
+            values[run.target + i] = place(n, std::move(values[run.source + i]));
+          }
+        }
+      }
+    }
+
+    //derives every generation after 0 again, given the runs of generation 0 and the types whose rules changed
+    //clean runs are split where they hold an edited type, rewritten runs are rewritten, and the successors of clean runs are moved from the old next generation
+    void derive(std::vector<LRun> runs, const std::unordered_set<T, Hash>& edited) {
+
+      const auto& table = system_.compiled();
+      const auto reach = reaching(edited);
+
+      rewritten_ = 0;
+
+      for(size_t g = 0; g + 1 < generations_.size(); ++g) {
+
+        const auto& current = generations_[g];
+        auto& old = generations_[g + 1];
+        auto& spans = spans_[g];
+
+        std::vector<LRun> classified;
+
+        for(const auto& run : runs) {
+
+          if(!run.clean || run.inert) {
+
+            append(classified, run);
+            continue;
+          }
+
+          //runs of one type are common, so a type is only looked up when it changes
+          std::optional<T> last;
+          LReach kind = LREACH_NONE;
+          size_t from = 0;
+
+          for(size_t i = 0; i <= run.size; ++i) {
+
+            const auto type = (i == run.size) ? std::optional<T>() : std::optional<T>(current[run.begin + i].type().representation());
+
+            if(i != 0 && (i == run.size || !(*type == *last))) {
+
+              append(classified, {run.begin + from, i - from, kind != LREACH_EDITED, kind == LREACH_NONE, run.old + from});
+              from = i;
+            }
+
+            if(type && (!last || !(*type == *last))) {
+
+              const auto found = reach.find(*type);
+
+              kind = (found == reach.end()) ? LREACH_NONE : found->second;
+              last = type;
+            }
+          }
+        }
+
+        std::vector<LRun> pieces;
+
+        for(const auto& run : classified) {
+
+          coalesce(pieces, run);
+        }
+
+        //nothing in this generation changed, so neither did the next one nor where its symbols came from
+        if(pieces.size() == 1 && pieces[0].clean && pieces[0].old == 0 && pieces[0].size == current.size() && spans.size() == current.size() + 1) {
+
+          runs = {{0, old.size(), true, pieces[0].inert, 0}};
+          continue;
+        }
+
+        //where each piece's successors go in the next generation, rewritten pieces are matched and measured first
+        std::vector<size_t> targets(pieces.size() + 1, 0);
+        std::vector<LRuleIndex> matched;
+        std::vector<size_t> lengths;
+
+        for(size_t n = 0; n < pieces.size(); ++n) {
+
+          const auto& piece = pieces[n];
+
+          if(piece.clean) {
+
+            targets[n + 1] = targets[n] + (spans[piece.old + piece.size] - spans[piece.old]);
+          }
+          else {
+
+            targets[n + 1] = targets[n] + measure(table, current, piece, static_cast<int>(g), matched, lengths);
+          }
+        }
+
+        //the next generation is spliced in place, clean successors moved to their new positions and the others rewritten around them
+        std::vector<LShift> symbolShifts;
+        std::vector<LShift> spanShifts;
+        std::vector<std::pair<size_t, size_t>> offsets; //clean piece -> where its successors were and will be
+        std::vector<LRun> nextRuns;
+
+        for(size_t n = 0; n < pieces.size(); ++n) {
+
+          const auto& piece = pieces[n];
+          const auto size = targets[n + 1] - targets[n];
+
+          if(piece.clean) {
+
+            const auto first = spans[piece.old];
+
+            symbolShifts.push_back({first, targets[n], size, false});
+            spanShifts.push_back({piece.old, piece.begin, piece.size, first != targets[n]});
+            offsets.emplace_back(first, targets[n]);
+          }
+
+          append(nextRuns, {targets[n], size, piece.clean, piece.clean && piece.inert, piece.clean ? spans[piece.old] : 0});
+        }
+
+        if(targets.back() <= old.capacity()) {
+
+          if(targets.back() > old.size()) {
+
+            old.resize(targets.back(), current[0]); //placeholder symbols, all of them are overwritten below
+          }
+
+          shift(old, symbolShifts, [](size_t, LSymbol<T>&& symbol) -> LSymbol<T>&& { return std::move(symbol); });
+        }
+        else {
+
+          //growing the generation in place would move it twice, so it is spliced into a new buffer with room for a few more edits
+          LString<T> next;
+          next.reserve(targets.back() + targets.back() / 4);
+
+          for(size_t n = 0; n < pieces.size(); ++n) {
+
+            if(pieces[n].clean) {
+
+              const auto first = old.data() + spans[pieces[n].old];
+
+              next.insert(next.end(), std::make_move_iterator(first), std::make_move_iterator(first + (targets[n + 1] - targets[n])));
+            }
+            else {
+
+              next.insert(next.end(), targets[n + 1] - targets[n], current[0]); //placeholder symbols, overwritten below
+            }
+          }
+
+          old = std::move(next);
+        }
+
+        spans.resize(std::max(spans.size(), current.size() + 1));
+
+        shift(spans, spanShifts, [&](size_t n, size_t span) { return offsets[n].second + (span - offsets[n].first); });
+
+        //rewritten pieces take their matched rules and lengths in order
+        size_t measured = 0;
+
+        for(size_t n = 0; n < pieces.size(); ++n) {
+
+          const auto& piece = pieces[n];
+
+          if(piece.clean) {
+
+            continue;
+          }
+
+          const auto* first = current.data() + piece.begin;
+          const auto* rules = table.conditional() ? matched.data() + measured : nullptr;
+          auto position = targets[n];
+
+          for(size_t i = 0; i < piece.size; ++i) {
+
+            spans[piece.begin + i] = position;
+            position += lengths[measured + i];
+          }
+
+          measured += piece.size;
+
+          table.rewrite(first, first + piece.size, old.data() + targets[n], rules, key(static_cast<int>(g), piece.begin));
+          table.parameterize(first, first + piece.size, old.data() + targets[n], rules, key(static_cast<int>(g), piece.begin));
+
+          rewritten_ += piece.size;
+        }
+
+        old.erase(old.begin() + static_cast<std::ptrdiff_t>(targets.back()), old.end());
+        spans.resize(current.size() + 1);
+        spans[current.size()] = targets.back();
+
+        runs = std::move(nextRuns);
+      }
+    }
+
+    //derives again after an edit, runs are those of generation 0
+    void rederive(std::vector<LRun> runs, const std::unordered_set<T, Hash>& edited) {
+
+      const auto& table = system_.compiled();
+
+      //stochastic draws depend on positions, which shift, and contexts reach across runs, so such systems are derived in full
+      if(table.stochastic() || table.contextSensitive()) {
+
+        runs = {{0, generations_[0].size(), false, false, 0}};
+      }
+
+      derive(std::move(runs), edited);
+    }
+
+  public:
+
+    //a negative number of generations keeps the axiom alone, as with generate
+    LIncremental(LSystem<T, Hash> system, int generations) : system_(std::move(system)) {
+
+      generations = std::max(0, generations);
+
+      generations_.resize(static_cast<size_t>(generations) + 1);
+      spans_.resize(static_cast<size_t>(generations));
+      generations_[0] = system_.axiom();
+
+      derive({{0, generations_[0].size(), false, false, 0}}, {});
+    }
+
+    //adds a rule to the system, then rewrites only what descends from symbols of its predecessor type
+    void addRule(LRule<T> rule) {
+
+      const auto predecessor = rule.predecessor().representation();
+
+      system_.addRule(std::move(rule));
+      rederive({{0, generations_[0].size(), true, false, 0}}, {predecessor});
+    }
+
+    //sets the axiom, then rewrites only what descends from the symbols between the prefix and suffix the old and new axioms share
+    void setAxiom(const LString<T>& axiom) {
+
+      const auto& previous = generations_[0];
+
+      size_t prefix = 0;
+      size_t suffix = 0;
+
+      while(prefix < std::min(axiom.size(), previous.size()) && sameSymbol(axiom[prefix], previous[prefix])) {
+
+        ++prefix;
+      }
+
+      while(suffix < std::min(axiom.size(), previous.size()) - prefix && sameSymbol(axiom[axiom.size() - suffix - 1], previous[previous.size() - suffix - 1])) {
+
+        ++suffix;
+      }
+
+      std::vector<LRun> runs;
+
+      append(runs, {0, prefix, true, true, 0});
+      append(runs, {prefix, axiom.size() - prefix - suffix, false, false, 0});
+      append(runs, {axiom.size() - suffix, suffix, true, true, previous.size() - suffix});
+
+      system_.setAxiom(axiom);
+      generations_[0] = axiom;
+
+      rederive(std::move(runs), {});
+    }
+
+    auto system() const noexcept -> const LSystem<T, Hash>& {
+
+      return system_;
+    }
+
+    //the deepest generation kept
+    auto generations() const noexcept -> int {
+
+      return static_cast<int>(spans_.size());
+    }
+
+    auto generation(int generation) const noexcept -> const LString<T>& {
+
+      return generations_[static_cast<size_t>(generation)];
+    }
+
+    auto result() const noexcept -> const LString<T>& {
+
+      return generations_.back();
+    }
+
+    //the symbols rewritten by the last derivation over all generations, the rest were spliced from the generations before it
+    auto rewritten() const noexcept -> size_t {
+
+      return rewritten_;
+    }
+  };
+}
+
+#endif
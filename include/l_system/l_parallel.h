@@ -0,0 +1,149 @@
+#ifndef L_SYSTEM_PARALLEL_H
+#define L_SYSTEM_PARALLEL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace l_system {
+
+  //below this many symbols per thread, splitting a generation costs more than it saves
+  constexpr const static size_t PARALLEL_GRAIN = 1 << 14;
+
+  //the number of threads worth using for size items, at most maxThreads and at least one
+  inline auto usefulThreads(size_t size, unsigned maxThreads) noexcept -> unsigned {
+
+    const auto byGrain = size / PARALLEL_GRAIN;
+
+    return static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(maxThreads, byGrain)));
+  }
+
+  //the first index of chunk n when size items are split into count near-equal contiguous chunks
+  inline auto chunkBegin(size_t size, size_t count, size_t n) noexcept -> size_t {
+
+    return (size / count) * n + std::min(n, size % count);
+  }
+
+  //runs first(n) for each n in [0, count), then between() once every first(n) has returned, then second(n) for each n
+  //the calling thread takes chunk 0 and one thread is started per other chunk, for both phases, chunks whose thread could not be started run on the calling thread
+  //the first exception thrown skips whatever has not started yet, and is rethrown on the calling thread once every thread has finished
+  template <typename First, typename Between, typename Second>
+  void parallelPhases(size_t count, First&& first, Between&& between, Second&& second) {
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    size_t arrived = 0; //threads done with the first phase
+    bool released = false; //whether the second phase may start
+    std::exception_ptr error;
+
+    const auto guarded = [&](auto&& phase) {
+
+      try {
+
+        phase();
+      }
+      catch(...) {
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if(!error) {
+
+          error = std::current_exception();
+        }
+      }
+    };
+
+    const auto failed = [&]() {
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      return error != nullptr;
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(count);
+
+    size_t started = std::min<size_t>(count, 1);
+
+    for(; started < count; ++started) {
+
+      try {
+
+        threads.emplace_back([&, n = started]() {
+
+          guarded([&]() { first(n); });
+
+          std::unique_lock<std::mutex> lock(mutex);
+
+          ++arrived;
+          changed.notify_all();
+          changed.wait(lock, [&]() { return released; });
+
+          const auto skip = error != nullptr;
+          lock.unlock();
+
+          if(!skip) {
+
+            guarded([&]() { second(n); });
+          }
+        });
+      }
+      catch(const std::system_error&) {
+
+        break;
+      }
+    }
+
+    //chunk 0, and every chunk after the last thread started
+    const auto local = [&](auto&& phase) {
+
+      for(size_t n = 0; n < count && !failed(); n = (n == 0) ? std::max<size_t>(started, 1) : n + 1) {
+
+        guarded([&]() { phase(n); });
+      }
+    };
+
+    local(first);
+
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      changed.wait(lock, [&]() { return arrived == threads.size(); });
+    }
+
+    if(!failed()) {
+
+      guarded(between);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      released = true;
+    }
+
+    changed.notify_all();
+    local(second);
+
+    for(auto& thread : threads) {
+
+      thread.join();
+    }
+
+    if(error) {
+
+      std::rethrow_exception(error);
+    }
+  }
+
+  //runs task(n) for each n in [0, count), the calling thread takes chunk 0 and one thread is started per other chunk
+  template <typename F>
+  void parallelFor(size_t count, F&& task) {
+
+    parallelPhases(count, task, []() {}, [](size_t) {});
+  }
+}
+
+#endif
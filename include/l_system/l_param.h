@@ -2,6 +2,13 @@
 #define L_SYSTEM_PARAM_H
 
 #include <cassert>
+#include <cstring>
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+#include <string>
+#include <sstream>
 #include <iomanip>
 #include <vector>
 #include <algorithm>
@@ -11,23 +18,6 @@ namespace l_system {
 
   namespace {
 
-    template<typename T>
-    auto fromBytes(const std::vector<unsigned char>& source, size_t offset) noexcept -> T {
-
-      T t;
-
-      unsigned char bytes[sizeof(T)];
-
-      for(size_t i = 0; i < sizeof(bytes); i++) {
-
-        bytes[i] = source.at(i + offset);
-      }
-
-      memcpy(&t, &bytes, sizeof(t));
-
-      return t;
-    }
-
     template<typename T>
     auto toBytes(T t) noexcept -> std::array<unsigned char, sizeof(T)> {
 
@@ -144,14 +134,150 @@ namespace l_system {
     + (static_cast<LParameterDataSize>(parameterCount(set, LCUSTOM)) * customSize); //cast because unsigned char * unsigned char == signed int :/
   }
 
+  //the byte offset of the first parameter of a kind within the data of a parameter set
+  inline auto parameterOffset(LParameterSet set, LParameter param) noexcept -> LParameterDataSize {
+
+    switch (param) {
+      case LINT:
+        return sizeof(char) * parameterCount(set, LCHAR);
+      case LFLOAT:
+        return (sizeof(char) * parameterCount(set, LCHAR)) + (sizeof(int) * parameterCount(set, LINT));
+      case LCUSTOM:
+        return (sizeof(char) * parameterCount(set, LCHAR)) + (sizeof(int) * parameterCount(set, LINT)) + (sizeof(float) * parameterCount(set, LFLOAT));
+      default:
+        return 0;
+    }
+  }
+
+  //reads a parameter out of raw parameter data, laid out as in LParameterData
+  template<typename T>
+  auto readParameter(const unsigned char* data, LParameterDataSize offset) noexcept -> T {
+
+    T t;
+
+    memcpy(&t, data + offset, sizeof(t));
+
+    return t;
+  }
+
+  //the parameters of a symbol, stored as raw bytes in the order chars, ints, floats, custom data
+  //storage comes from a memory resource, the default one unless another is given, so symbols can live in arenas
+  //as with std::pmr containers, copies take the default resource and assignment keeps the resource of the assigned to data
   class LParameterData {
 
+    unsigned char* bytes_ = nullptr; //the data storage, null while the set has no parameters
+    std::pmr::memory_resource* resource_; //where bytes_ comes from
     LParameterSet set_; //the information about the set of parameters, 4 bytes
+    std::uint32_t capacity_ = 0; //bytes allocated, at least the size of the set's data
     LParameterCustomSize customSize_; //the information about the size of the custom parameter type, 1 byte
-    std::vector<unsigned char> bytes_; //the data storage, sizeof(vector) bytes, probably 20 bytes maximum
+
+    //makes room for size bytes, reusing the storage if it is large enough, the bytes are not kept
+    void reserve(LParameterDataSize size) {
+
+      if(size <= capacity_) {
+
+        return;
+      }
+
+      release();
+
+      bytes_ = static_cast<unsigned char*>(resource_->allocate(size, 1));
+      capacity_ = static_cast<std::uint32_t>(size);
+    }
+
+    void copy(const LParameterData& other) {
+
+      reserve(other.size());
+      set_ = other.set_;
+      customSize_ = other.customSize_;
+
+      if(size() > 0) {
+
+        memcpy(bytes_, other.bytes_, size());
+      }
+    }
+
+    void release() noexcept {
+
+      if(bytes_ != nullptr) {
+
+        resource_->deallocate(bytes_, capacity_, 1);
+        bytes_ = nullptr;
+        capacity_ = 0;
+      }
+    }
 
   public:
-    LParameterData(LParameterSet set, LParameterCustomSize customSize = 1) : set_(set), customSize_(customSize), bytes_(std::vector<unsigned char>(requiredDataSize(set, customSize))) {}
+
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    LParameterData(LParameterSet set, LParameterCustomSize customSize = 1, const allocator_type& allocator = {}) : resource_(allocator.resource()), set_(set), customSize_(customSize) {
+
+      reserve(size());
+
+      if(bytes_ != nullptr) {
+
+        memset(bytes_, 0, size());
+      }
+    }
+
+    LParameterData(const LParameterData& other, const allocator_type& allocator = {}) : resource_(allocator.resource()), set_(LNONE), customSize_(0) {
+
+      copy(other);
+    }
+
+    //the moved from data is left without parameters
+    LParameterData(LParameterData&& other) noexcept :
+      bytes_(std::exchange(other.bytes_, nullptr)),
+      resource_(other.resource_),
+      set_(std::exchange(other.set_, LNONE)),
+      capacity_(std::exchange(other.capacity_, 0)),
+      customSize_(other.customSize_) {}
+
+    ~LParameterData() {
+
+      release();
+    }
+
+    auto operator=(const LParameterData& other) -> LParameterData& {
+
+      if(this != &other) {
+
+        copy(other);
+      }
+
+      return *this;
+    }
+
+    //takes the other data's storage when both share a resource, otherwise copies into this one's
+    auto operator=(LParameterData&& other) -> LParameterData& {
+
+      if(this == &other) {
+
+        return *this;
+      }
+
+      if(*resource_ != *other.resource_) {
+
+        copy(other);
+
+        return *this;
+      }
+
+      release();
+
+      bytes_ = std::exchange(other.bytes_, nullptr);
+      capacity_ = std::exchange(other.capacity_, 0);
+      set_ = std::exchange(other.set_, LNONE);
+      customSize_ = other.customSize_;
+
+      return *this;
+    }
+
+    auto get_allocator() const noexcept -> allocator_type {
+
+      return allocator_type(resource_);
+    }
 
     auto set() const noexcept -> LParameterSet {
 
@@ -163,6 +289,22 @@ namespace l_system {
       return customSize_;
     }
 
+    auto size() const noexcept -> LParameterDataSize {
+
+      return requiredDataSize(set_, customSize_);
+    }
+
+    //the raw parameter bytes, chars first, then ints, floats and custom data
+    auto data() const noexcept -> const unsigned char* {
+
+      return bytes_;
+    }
+
+    auto data() noexcept -> unsigned char* {
+
+      return bytes_;
+    }
+
     auto getType(LParameterDataSize n) const noexcept -> LParameter {
 
       assert(n < totalParameterCount(set_) && "out of bounds parameter access.");
@@ -195,7 +337,7 @@ namespace l_system {
 
       size_t offset = 0;
 
-      return(static_cast<char>(bytes_.at(offset + n)));
+      return readParameter<char>(bytes_, offset + n);
     }
 
     auto getInt(LParameterCount n) const noexcept -> int {
@@ -204,7 +346,7 @@ namespace l_system {
 
       size_t offset = sizeof(char) * parameterCount(set_, LCHAR);
 
-      return fromBytes<int>(bytes_, offset + n * sizeof(int));
+      return readParameter<int>(bytes_, offset + n * sizeof(int));
     }
 
     auto getFloat(LParameterCount n) const noexcept -> float {
@@ -213,7 +355,7 @@ namespace l_system {
 
       size_t offset = (sizeof(char) * parameterCount(set_, LCHAR)) + (sizeof(int) * parameterCount(set_, LINT));
 
-      return fromBytes<float>(bytes_, offset + n * sizeof(float));
+      return readParameter<float>(bytes_, offset + n * sizeof(float));
     }
 
     auto getCustom(LParameterCount n) const noexcept -> std::vector<unsigned char> {
@@ -226,7 +368,7 @@ namespace l_system {
 
       for(size_t i = 0; i < customSize_; i++) {
 
-        bytes[i] = bytes_.at(i + offset + static_cast<size_t>(n * customSize_));
+        bytes[i] = bytes_[i + offset + static_cast<size_t>(n * customSize_)];
       }
 
       return bytes;
@@ -278,7 +420,7 @@ namespace l_system {
 
       for(size_t j = 0; j < customSize_; j++) {
 
-        bytes_[j + offset + static_cast<size_t>(n * customSize_)] = c.at(j);
+        bytes_[j + offset + static_cast<size_t>(n * customSize_)] = c[j];
       }
     }
   };
@@ -0,0 +1,43 @@
+#ifndef L_SYSTEM_RANDOM_H
+#define L_SYSTEM_RANDOM_H
+
+#include <cstdint>
+
+namespace l_system {
+
+  //the position of a range of symbols in a system's random stream, symbol i of the range draws counterRandom(seed, generation, position + i)
+  struct LRandomKey {
+
+    std::uint64_t seed = 0;
+    std::uint64_t generation = 0; //the generation being rewritten
+    std::uint64_t position = 0; //the index of the range's first symbol in that generation
+  };
+
+  //the splitmix64 finalizer, a bijection which spreads every input bit over the whole word
+  inline auto mix64(std::uint64_t x) noexcept -> std::uint64_t {
+
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+
+    return x;
+  }
+
+  //a counter-based random number, a pure function of its key rather than the next output of a stateful engine
+  //any symbol's draw can be computed on its own, so results do not depend on how generation is split between threads
+  inline auto counterRandom(std::uint64_t seed, std::uint64_t generation, std::uint64_t position) noexcept -> std::uint64_t {
+
+    constexpr const std::uint64_t golden = 0x9e3779b97f4a7c15ULL;
+
+    return mix64(mix64(mix64(seed + golden) ^ (generation * golden)) ^ (position + golden));
+  }
+
+  inline auto counterRandom(const LRandomKey& key, std::uint64_t offset) noexcept -> std::uint64_t {
+
+    return counterRandom(key.seed, key.generation, key.position + offset);
+  }
+}
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef L_SYSTEM_REGISTRY_H
+#define L_SYSTEM_REGISTRY_H
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "l_system/l_symbol.h"
+
+namespace l_system {
+
+  using LSymbolId = std::uint32_t;
+
+  constexpr const static LSymbolId NO_SYMBOL = std::numeric_limits<LSymbolId>::max();
+
+  //representations small enough to index a flat table directly, e.g. char or short
+  template <typename T>
+  constexpr const static bool isDenselyIndexable = std::is_integral_v<T> && sizeof(T) <= 2;
+
+  //whether Hash can be default constructed and called on a T, std::hash of a type without a specialization can not
+  template <typename T, typename Hash, typename = void>
+  struct isHasher : std::false_type {};
+
+  template <typename T, typename Hash>
+  struct isHasher<T, Hash, std::void_t<decltype(Hash()(std::declval<const T&>()))>> : std::true_type {};
+
+  //interns symbol types into dense ids, so strings and rules can refer to a type with a single integer
+  //types are identified by representation, as in LSymbolType's operator==, the first type registered for a representation is kept
+  //representations are looked up in a flat table for small integral types, with Hash if it is usable, and by a scan of the types otherwise
+  template <typename T, typename Hash = std::hash<T>>
+  class LSymbolRegistry {
+
+    using Index = std::conditional_t<isDenselyIndexable<T>,
+      std::vector<LSymbolId>,
+      std::conditional_t<isHasher<T, Hash>::value,
+        std::unordered_map<T, LSymbolId, Hash>,
+        std::vector<LSymbolId>>>; //unused by the scanning fallback
+
+    std::vector<LSymbolType<T>> types_; //id -> symbol type
+    Index index_; //representation -> id
+
+    static auto denseIndex(T representation) noexcept -> size_t {
+
+      return static_cast<size_t>(static_cast<long long>(representation) - static_cast<long long>(std::numeric_limits<T>::min()));
+    }
+
+    static constexpr auto denseSize() noexcept -> size_t {
+
+      return static_cast<size_t>(static_cast<long long>(std::numeric_limits<T>::max()) - static_cast<long long>(std::numeric_limits<T>::min())) + 1;
+    }
+
+  public:
+
+    //the id of a type, adding it if its representation has not been seen
+    auto intern(const LSymbolType<T>& type) -> LSymbolId {
+
+      auto id = find(type.representation());
+
+      if(id != NO_SYMBOL) {
+
+        return id;
+      }
+
+      id = static_cast<LSymbolId>(types_.size());
+      types_.emplace_back(type);
+
+      if constexpr (isDenselyIndexable<T>) {
+
+        if(index_.empty()) {
+
+          index_.assign(denseSize(), NO_SYMBOL);
+        }
+
+        index_[denseIndex(type.representation())] = id;
+      }
+      else if constexpr (isHasher<T, Hash>::value) {
+
+        index_.emplace(type.representation(), id);
+      }
+
+      return id;
+    }
+
+    //the id of a representation, or NO_SYMBOL if it has not been interned
+    auto find(const T& representation) const noexcept -> LSymbolId {
+
+      if constexpr (isDenselyIndexable<T>) {
+
+        return index_.empty() ? NO_SYMBOL : index_[denseIndex(representation)];
+      }
+      else if constexpr (isHasher<T, Hash>::value) {
+
+        auto found = index_.find(representation);
+
+        return (found == index_.end()) ? NO_SYMBOL : found->second;
+      }
+      else {
+
+        const LSymbolType<T> type(representation);
+
+        for(size_t id = 0; id < types_.size(); ++id) {
+
+          if(types_[id] == type) {
+
+            return static_cast<LSymbolId>(id);
+          }
+        }
+
+        return NO_SYMBOL;
+      }
+    }
+
+    auto type(LSymbolId id) const noexcept -> const LSymbolType<T>& {
+
+      return types_[id];
+    }
+
+    auto types() const noexcept -> const std::vector<LSymbolType<T>>& {
+
+      return types_;
+    }
+
+    auto size() const noexcept -> size_t {
+
+      return types_.size();
+    }
+  };
+}
+
+#endif
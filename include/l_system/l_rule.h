@@ -1,26 +1,152 @@
 #ifndef L_SYSTEM_RULE_H
 #define L_SYSTEM_RULE_H
 
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
 #include "l_system/l_symbol.h"
 #include "l_system/l_param.h"
+#include "l_system/l_expression.h"
 
 namespace l_system {
 
+  using LRuleIndex = std::uint32_t;
+
+  constexpr const static LRuleIndex NO_RULE = std::numeric_limits<LRuleIndex>::max();
+
+  //one of the successors of a stochastic rule, chosen with a probability proportional to its weight
+  template <typename T>
+  struct LAlternative {
+
+    double weight;
+    LTypeString<T> result;
+  };
+
+  template <typename T>
+  using LAlternatives = std::vector<LAlternative<T>>;
+
+  //a rule rewriting predecessor into result, optionally only where it is preceded by left and followed by right, as in left < predecessor > right
+  //a stochastic rule has several weighted alternative results, of which one is drawn for every symbol it rewrites
+  //a parametric rule only applies where its guard holds, and computes the parameters of its result from the predecessor's
   template <typename T>
   class LRule {
 
+    LTypeString<T> left_;
     LSymbolType<T> predecessor_;
-    LTypeString<T> result_;
+    LTypeString<T> right_;
+    LAlternatives<T> alternatives_;
+    std::optional<LExpression> guard_;
+    std::vector<std::vector<LParameterExpression>> expressions_; //alternative -> the expressions setting its parameters
+
+    //an alternative's result, each symbol followed by the expressions setting its parameters, as in F(f0=(f0*0.5))
+    auto representResult(size_t alternative) const -> std::string {
+
+      std::ostringstream stream;
+      const auto& result = alternatives_[alternative].result;
+
+      for(size_t symbol = 0; symbol < result.size(); ++symbol) {
+
+        stream << result[symbol].representation();
+
+        const char* separator = "(";
+
+        for(const auto& expression : expressions_[alternative]) {
+
+          if(expression.symbol == symbol) {
+
+            stream << separator << ((expression.kind == LCHAR) ? 'c' : (expression.kind == LINT) ? 'i' : 'f') << static_cast<unsigned int>(expression.n) << '=' << expression.expression.representation();
+            separator = ",";
+          }
+        }
+
+        if(separator[0] == ',') {
+
+          stream << ')';
+        }
+      }
+
+      return stream.str();
+    }
 
   public:
 
     LRule(LSymbolType<T> predecessor, LTypeString<T> result) :
       predecessor_(predecessor),
-      result_(result) {}
+      alternatives_({{1.0, result}}),
+      expressions_(1) {}
+
+    LRule(LTypeString<T> left, LSymbolType<T> predecessor, LTypeString<T> right, LTypeString<T> result) :
+      left_(left),
+      predecessor_(predecessor),
+      right_(right),
+      alternatives_({{1.0, result}}),
+      expressions_(1) {}
+
+    LRule(LSymbolType<T> predecessor, LAlternatives<T> alternatives) :
+      predecessor_(predecessor),
+      alternatives_(alternatives),
+      expressions_(alternatives.size()) {
 
+      assert(!alternatives_.empty() && "a rule needs at least one result.");
+    }
+
+    LRule(LTypeString<T> left, LSymbolType<T> predecessor, LTypeString<T> right, LAlternatives<T> alternatives) :
+      left_(left),
+      predecessor_(predecessor),
+      right_(right),
+      alternatives_(alternatives),
+      expressions_(alternatives.size()) {
+
+      assert(!alternatives_.empty() && "a rule needs at least one result.");
+    }
+
+    //the result of a deterministic rule, or the first alternative of a stochastic one
     auto result() const noexcept -> LTypeString<T> {
 
-      return result_;
+      return alternatives_.front().result;
+    }
+
+    auto alternatives() const noexcept -> const LAlternatives<T>& {
+
+      return alternatives_;
+    }
+
+    auto stochastic() const noexcept -> bool {
+
+      return alternatives_.size() > 1;
+    }
+
+    //only lets the rule apply to symbols for which guard is not 0
+    void setGuard(const LExpression& guard) noexcept {
+
+      guard_ = guard;
+    }
+
+    auto guard() const noexcept -> const std::optional<LExpression>& {
+
+      return guard_;
+    }
+
+    //computes parameter n of a kind of one symbol of a result from the predecessor's parameters, rather than leaving it zeroed
+    void setParameter(size_t symbol, LParameter kind, LParameterCount n, const LExpression& expression, size_t alternative = 0) {
+
+      assert(alternative < alternatives_.size() && "out of bounds alternative.");
+      assert(symbol < alternatives_[alternative].result.size() && "out of bounds result symbol.");
+      assert(n < parameterCount(alternatives_[alternative].result[symbol].paramSet(), kind) && "out of bounds parameter assignment.");
+
+      expressions_[alternative].push_back({symbol, kind, n, expression});
+    }
+
+    auto expressions(size_t alternative = 0) const noexcept -> const std::vector<LParameterExpression>& {
+
+      return expressions_[alternative];
+    }
+
+    auto parametric() const noexcept -> bool {
+
+      return guard_ || std::any_of(expressions_.begin(), expressions_.end(), [](const auto& expressions) { return !expressions.empty(); });
     }
 
     auto predecessor() const noexcept -> LSymbolType<T> {
@@ -28,19 +154,46 @@ namespace l_system {
       return predecessor_;
     }
 
+    auto left() const noexcept -> const LTypeString<T>& {
+
+      return left_;
+    }
+
+    auto right() const noexcept -> const LTypeString<T>& {
+
+      return right_;
+    }
+
+    auto contextFree() const noexcept -> bool {
+
+      return left_.empty() && right_.empty();
+    }
+
+    //whether the rule's predecessor matches and its guard holds, contexts are matched by the system
     auto applies(LSymbol<T> symbol) const noexcept -> bool {
 
-      return symbol.type() == predecessor_;
+      return symbol.type() == predecessor_ && (!guard_ || guard_->evaluate(symbol.parameters().data(), symbol.paramSet()) != 0.0f);
     }
 
-    auto produce(LSymbol<T> symbol) const noexcept -> LString<T> {
+    //one symbol's rewriting, systems evaluate expressions for many symbols at once instead
+    auto produce(LSymbol<T> symbol, size_t alternative = 0) const noexcept -> LString<T> {
+
+      const auto& types = alternatives_.at(alternative).result;
 
       LString<T> result;
-      result.reserve(result_.size());
+      result.reserve(types.size());
+
+      for(size_t symbolIndex = 0; symbolIndex < types.size(); ++symbolIndex) {
+
+        result.emplace_back(LSymbol<T>(types.at(symbolIndex)));
+      }
+
+      for(const auto& expression : expressions_.at(alternative)) {
 
-      for(size_t symbolIndex = 0; symbolIndex < result_.size(); ++symbolIndex) {
+        auto& target = result[expression.symbol];
+        const auto value = expression.expression.evaluate(symbol.parameters().data(), symbol.paramSet());
 
-        result.emplace_back(LSymbol<T>(result_.at(symbolIndex)));
+        writeParameter(target.parameters().data(), parameterOffset(target.paramSet(), expression.kind) + expression.n * parameterSize(expression.kind), expression.kind, value);
       }
 
       return result;
@@ -50,9 +203,34 @@ namespace l_system {
 
       std::ostringstream stream;
 
+      if(!left_.empty()) {
+
+        stream << represent(left_) << '<';
+      }
+
       stream << predecessor_.representation();
+
+      if(!right_.empty()) {
+
+        stream << '>' << represent(right_);
+      }
+
+      if(guard_) {
+
+        stream << ':' << guard_->representation();
+      }
+
       stream << "->";
-      stream << represent(result_);
+
+      if(!stochastic()) {
+
+        stream << representResult(0);
+      }
+
+      for(size_t alternative = 0; stochastic() && alternative < alternatives_.size(); ++alternative) {
+
+        stream << (alternative == 0 ? "" : "|") << '(' << alternatives_[alternative].weight << ')' << representResult(alternative);
+      }
 
       return stream.str();
     }
@@ -0,0 +1,136 @@
+#ifndef L_SYSTEM_SCHEMA_H
+#define L_SYSTEM_SCHEMA_H
+
+#include <array>
+#include <type_traits>
+
+#include "l_system/l_param.h"
+
+namespace l_system {
+
+  //a parameter set fixed at compile time
+  //offsets are constants and the data is stored inline, so every access is a load or store at a fixed offset
+  //the byte layout is the same as LParameterData's, chars first, then ints, floats and custom data, whatever the order of Params
+  template <LParameterCustomSize CustomSize, LParameter... Params>
+  class LBasicParams {
+
+    static constexpr auto count(LParameter param) noexcept -> LParameterCount {
+
+      return static_cast<LParameterCount>((0 + ... + (Params == param ? 1 : 0)));
+    }
+
+  public:
+
+    constexpr const static LParameterCount chars = count(LCHAR);
+    constexpr const static LParameterCount ints = count(LINT);
+    constexpr const static LParameterCount floats = count(LFLOAT);
+    constexpr const static LParameterCount customs = count(LCUSTOM);
+
+    constexpr const static LParameterSet set = (chars * LCHAR) + (ints * LINT) + (floats * LFLOAT) + (customs * LCUSTOM);
+    constexpr const static LParameterCustomSize customSize = CustomSize;
+
+    constexpr const static LParameterDataSize intOffset = sizeof(char) * chars;
+    constexpr const static LParameterDataSize floatOffset = intOffset + sizeof(int) * ints;
+    constexpr const static LParameterDataSize customOffset = floatOffset + sizeof(float) * floats;
+    constexpr const static LParameterDataSize size = customOffset + static_cast<LParameterDataSize>(CustomSize) * customs;
+
+  private:
+
+    std::array<unsigned char, (size > 0) ? size : 1> bytes_ = {};
+
+  public:
+
+    template <LParameterCount N>
+    auto getChar() const noexcept -> char {
+
+      static_assert(N < chars, "out of bounds parameter access.");
+
+      return static_cast<char>(bytes_[N]);
+    }
+
+    template <LParameterCount N>
+    auto getInt() const noexcept -> int {
+
+      static_assert(N < ints, "out of bounds parameter access.");
+
+      return readParameter<int>(bytes_.data(), intOffset + N * sizeof(int));
+    }
+
+    template <LParameterCount N>
+    auto getFloat() const noexcept -> float {
+
+      static_assert(N < floats, "out of bounds parameter access.");
+
+      return readParameter<float>(bytes_.data(), floatOffset + N * sizeof(float));
+    }
+
+    template <LParameterCount N>
+    auto getCustom() const noexcept -> std::array<unsigned char, CustomSize> {
+
+      static_assert(N < customs, "out of bounds parameter access.");
+
+      return readParameter<std::array<unsigned char, CustomSize>>(bytes_.data(), customOffset + N * static_cast<size_t>(CustomSize));
+    }
+
+    template <LParameterCount N>
+    void setChar(char c) noexcept {
+
+      static_assert(N < chars, "out of bounds parameter assignment.");
+
+      bytes_[N] = static_cast<unsigned char>(c);
+    }
+
+    template <LParameterCount N>
+    void setInt(int i) noexcept {
+
+      static_assert(N < ints, "out of bounds parameter assignment.");
+
+      memcpy(bytes_.data() + intOffset + N * sizeof(int), &i, sizeof(i));
+    }
+
+    template <LParameterCount N>
+    void setFloat(float f) noexcept {
+
+      static_assert(N < floats, "out of bounds parameter assignment.");
+
+      memcpy(bytes_.data() + floatOffset + N * sizeof(float), &f, sizeof(f));
+    }
+
+    template <LParameterCount N>
+    void setCustom(const std::array<unsigned char, CustomSize>& c) noexcept {
+
+      static_assert(N < customs, "out of bounds parameter assignment.");
+
+      memcpy(bytes_.data() + customOffset + N * static_cast<size_t>(CustomSize), c.data(), CustomSize);
+    }
+
+    auto data() const noexcept -> const unsigned char* {
+
+      return bytes_.data();
+    }
+
+    //conversions to and from the runtime parameter representation, which must have the same set and custom size
+    static auto fromData(const LParameterData& data) noexcept -> LBasicParams {
+
+      assert(data.set() == set && (customs == 0 || data.customSize() == CustomSize) && "mismatched parameter set.");
+
+      LBasicParams params;
+      std::copy(data.data(), data.data() + size, params.bytes_.data());
+
+      return params;
+    }
+
+    auto toData() const -> LParameterData {
+
+      LParameterData data(set, CustomSize);
+      std::copy(bytes_.data(), bytes_.data() + size, data.data());
+
+      return data;
+    }
+  };
+
+  template <LParameter... Params>
+  using LParams = LBasicParams<1, Params...>;
+}
+
+#endif
@@ -0,0 +1,284 @@
+#ifndef L_SYSTEM_SHARD_H
+#define L_SYSTEM_SHARD_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "l_system/l_dag.h"
+#include "l_system/l_disk.h"
+
+namespace l_system {
+
+  //bumped whenever the manifest's layout changes, manifests of another version are refused
+  constexpr const static std::uint32_t LSHARD_VERSION = 1;
+
+  //the symbols [begin, end) of a generation held by one shard
+  struct LShardRange {
+
+    LCount begin;
+    LCount end;
+
+    auto size() const noexcept -> LCount {
+
+      return end - begin;
+    }
+  };
+
+  //how a sharded generation is put back together, every shard's range and file in order
+  //files are named relative to the manifest's directory, so the directory can be moved as a whole
+  struct LShardManifest {
+
+    int generation = 0;
+    LCount length = 0;
+    std::vector<LShardRange> ranges;
+    std::vector<std::string> files;
+
+    //where the manifest of a generation is kept in a directory, beside its shards
+    static auto path(const std::string& directory, int generation) -> std::string {
+
+      return directory + "/" + std::to_string(generation) + ".manifest";
+    }
+
+    //written as text, a header line and then one line per shard of its index, first symbol, end and file
+    auto save(std::ostream& out) const -> bool {
+
+      out << "lshards " << LSHARD_VERSION << '\n';
+      out << "generation " << generation << '\n';
+      out << "length " << length << '\n';
+      out << "shards " << ranges.size() << '\n';
+
+      for(size_t k = 0; k < ranges.size(); ++k) {
+
+        out << k << ' ' << ranges[k].begin << ' ' << ranges[k].end << ' ' << files[k] << '\n';
+      }
+
+      return !out.fail();
+    }
+
+    //reads a manifest written by save, or nothing if the stream does not hold a consistent one
+    static auto load(std::istream& in) -> std::optional<LShardManifest> {
+
+      std::string word;
+      std::uint32_t version = 0;
+      size_t shards = 0;
+      LShardManifest result;
+
+      if(!(in >> word) || word != "lshards" || !(in >> version) || version != LSHARD_VERSION) {
+
+        return std::nullopt;
+      }
+
+      if(!(in >> word) || word != "generation" || !(in >> result.generation)) {
+
+        return std::nullopt;
+      }
+
+      if(!(in >> word) || word != "length" || !(in >> result.length)) {
+
+        return std::nullopt;
+      }
+
+      if(!(in >> word) || word != "shards" || !(in >> shards)) {
+
+        return std::nullopt;
+      }
+
+      //shards must follow each other without gaps and cover the whole generation
+      LCount position = 0;
+
+      for(size_t k = 0; k < shards; ++k) {
+
+        size_t index = 0;
+        LShardRange range{};
+        std::string file;
+
+        if(!(in >> index >> range.begin >> range.end >> file) || index != k || range.begin != position || range.end < range.begin) {
+
+          return std::nullopt;
+        }
+
+        position = range.end;
+        result.ranges.push_back(range);
+        result.files.emplace_back(std::move(file));
+      }
+
+      if(position != result.length) {
+
+        return std::nullopt;
+      }
+
+      return result;
+    }
+
+    static auto open(const std::string& directory, int generation) -> std::optional<LShardManifest> {
+
+      std::ifstream in(path(directory, generation));
+
+      return in ? load(in) : std::nullopt;
+    }
+
+    //the shards in a directory as one generation on disk, or nothing if a shard is missing or does not hold its range
+    //shards are named as LDiskString names chunks, so each is checked under the name the generation reads it by
+    //the shards are mapped to check their sizes, not read
+    template <typename T, typename Hash = std::hash<T>>
+    auto assemble(const std::string& directory) const -> std::optional<LDiskString<T, Hash>> {
+
+      LDiskString<T, Hash> result(directory, generation);
+
+      for(size_t k = 0; k < ranges.size(); ++k) {
+
+        const auto mapped = LMappedString<T, Hash>::open(result.path(k));
+
+        if(!mapped || mapped->size() != ranges[k].size()) {
+
+          return std::nullopt;
+        }
+
+        result.append(mapped->size());
+      }
+
+      return result;
+    }
+  };
+
+  //splits a generation into contiguous shards of near-equal length, any of which can be produced on its own
+  //shard boundaries come from the exact length of the generation, found from the axiom and rules without generating it,
+  //so every process planning the same system, generation and shard count agrees on them and writes its shards independently
+  //each shard is produced by descending the generation's derivation straight to its first symbol, never producing the symbols before it
+  //only for rules which rewrite every symbol of a type alike, that is deterministic context-free rules without guards or parameter expressions
+  template <typename T, typename Hash = std::hash<T>>
+  class LShards {
+
+    LDerivation<T, Hash> derivation_;
+    LCount length_;
+    size_t count_;
+
+    LShards(LDerivation<T, Hash> derivation, size_t count) : derivation_(std::move(derivation)), length_(0), count_(count) {}
+
+  public:
+
+    //the plan for count shards of a generation, or nothing if the rules are not uniform, count is 0, or the generation's length overflows
+    static auto plan(const LSystem<T, Hash>& system, int generations, size_t count) -> std::optional<LShards> {
+
+      auto derivation = LDerivation<T, Hash>::derive(system, generations);
+
+      if(!derivation || count == 0) {
+
+        return std::nullopt;
+      }
+
+      LShards result(std::move(*derivation), count);
+      const auto length = result.derivation_.length();
+
+      if(!length) {
+
+        return std::nullopt;
+      }
+
+      result.length_ = *length;
+
+      return result;
+    }
+
+    auto generations() const noexcept -> int {
+
+      return derivation_.generations();
+    }
+
+    //the length of the whole generation
+    auto length() const noexcept -> LCount {
+
+      return length_;
+    }
+
+    auto count() const noexcept -> size_t {
+
+      return count_;
+    }
+
+    //the symbols of shard k, the first length % count shards holding one symbol more than the rest
+    auto range(size_t k) const noexcept -> LShardRange {
+
+      assert(k < count_ && "out of bounds shard.");
+
+      const auto shards = static_cast<LCount>(count_);
+      const auto size = length_ / shards;
+      const auto rest = length_ % shards;
+      const auto begin = k * size + std::min<LCount>(k, rest);
+
+      return {begin, begin + size + (k < rest ? 1u : 0u)};
+    }
+
+    //the symbols of shard k, lazily
+    auto slice(size_t k) const noexcept {
+
+      const auto shard = range(k);
+
+      return derivation_.slice(shard.begin, shard.end);
+    }
+
+    auto materialize(size_t k) const -> LString<T> {
+
+      const auto shard = range(k);
+
+      return derivation_.materialize(shard.begin, shard.end);
+    }
+
+    //the file name of shard k, the name chunk k of the generation has in an LDiskString
+    auto file(size_t k) const -> std::string {
+
+      return LDiskString<T, Hash>::chunkFile(generations(), k);
+    }
+
+    //writes shard k to its file in directory, returning whether it was written in full
+    //empty shards are written too, so the shards of a directory are numbered like its chunks
+    auto write(const std::string& directory, size_t k) const -> bool {
+
+      const auto lstring = materialize(k);
+
+      std::ofstream out(LDiskString<T, Hash>::chunkPath(directory, generations(), k), std::ios::binary);
+
+      const auto saved = save<T, Hash>(out, lstring);
+      out.close();
+
+      return saved && !out.fail();
+    }
+
+    auto manifest() const -> LShardManifest {
+
+      LShardManifest result;
+
+      result.generation = generations();
+      result.length = length_;
+
+      for(size_t k = 0; k < count_; ++k) {
+
+        result.ranges.push_back(range(k));
+        result.files.push_back(file(k));
+      }
+
+      return result;
+    }
+
+    //writes the manifest beside the shards, it needs none of them written and any process of the plan may write it
+    auto writeManifest(const std::string& directory) const -> bool {
+
+      std::ofstream out(LShardManifest::path(directory, generations()));
+
+      const auto saved = manifest().save(out);
+      out.close();
+
+      return saved && !out.fail();
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,214 @@
+#ifndef L_SYSTEM_SINK_H
+#define L_SYSTEM_SINK_H
+
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#define L_SYSTEM_DESCRIPTORS 1
+#endif
+
+#include "l_system/l_compact.h"
+#include "l_system/l_parallel.h"
+
+namespace l_system {
+
+  //a sink is anything with write(const char* data, size_t size) -> bool, which returns false once output has failed
+  //format writes text to sinks a block at a time, never a symbol at a time
+
+  //writes into a buffer the caller owns, a write which does not fit fails and writes nothing
+  class LBufferSink {
+
+    char* data_;
+    size_t capacity_;
+    size_t size_ = 0;
+
+  public:
+
+    LBufferSink(char* data, size_t capacity) noexcept : data_(data), capacity_(capacity) {}
+
+    auto write(const char* data, size_t size) noexcept -> bool {
+
+      if(size > capacity_ - size_) {
+
+        return false;
+      }
+
+      memcpy(data_ + size_, data, size);
+      size_ += size;
+
+      return true;
+    }
+
+    //the number of characters written so far
+    auto size() const noexcept -> size_t {
+
+      return size_;
+    }
+  };
+
+  //appends to a string
+  class LStringSink {
+
+    std::string& out_;
+
+  public:
+
+    LStringSink(std::string& out) noexcept : out_(out) {}
+
+    auto write(const char* data, size_t size) -> bool {
+
+      out_.append(data, size);
+
+      return true;
+    }
+  };
+
+  class LStreamSink {
+
+    std::ostream& out_;
+
+  public:
+
+    LStreamSink(std::ostream& out) noexcept : out_(out) {}
+
+    auto write(const char* data, size_t size) -> bool {
+
+      out_.write(data, static_cast<std::streamsize>(size));
+
+      return out_.good();
+    }
+  };
+
+#ifdef L_SYSTEM_DESCRIPTORS
+
+  //writes straight to a file descriptor, such as an open file, a pipe or standard output, which the caller keeps open
+  class LDescriptorSink {
+
+    int descriptor_;
+
+  public:
+
+    LDescriptorSink(int descriptor) noexcept : descriptor_(descriptor) {}
+
+    auto write(const char* data, size_t size) noexcept -> bool {
+
+      while(size > 0) {
+
+        const auto written = ::write(descriptor_, data, size);
+
+        if(written < 0 && errno == EINTR) {
+
+          continue;
+        }
+
+        if(written <= 0) {
+
+          return false;
+        }
+
+        data += written;
+        size -= static_cast<size_t>(written);
+      }
+
+      return true;
+    }
+  };
+
+#endif
+
+  //symbols formatted into one block of text before it is written
+  constexpr const static size_t LFORMAT_BLOCK = 1 << 16;
+
+  //formats size symbols a block at a time with formatBlock(first, last, text), which appends the text of symbols [first, last)
+  //with several threads, each formats a block of a round in parallel, while the round before is written in order
+  template <typename Sink, typename F>
+  auto formatBlocks(Sink& sink, size_t size, unsigned threads, F&& formatBlock) -> bool {
+
+    const auto blocks = (size + LFORMAT_BLOCK - 1) / LFORMAT_BLOCK;
+    const auto blockEnd = [&](size_t block) { return std::min(size, (block + 1) * LFORMAT_BLOCK); };
+
+    if(threads <= 1 || blocks <= 1) {
+
+      std::string text;
+
+      for(size_t block = 0; block < blocks; ++block) {
+
+        text.clear();
+        formatBlock(block * LFORMAT_BLOCK, blockEnd(block), text);
+
+        if(!sink.write(text.data(), text.size())) {
+
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    //one round is formatted into one set of texts while the other set is written
+    std::vector<std::string> texts[2] = {std::vector<std::string>(threads), std::vector<std::string>(threads)};
+    std::future<bool> written;
+
+    for(size_t round = 0; round * threads < blocks; ++round) {
+
+      auto& current = texts[round % 2];
+      const auto first = round * threads;
+      const auto count = std::min<size_t>(threads, blocks - first);
+
+      parallelFor(count, [&](size_t n) {
+
+        current[n].clear();
+        formatBlock((first + n) * LFORMAT_BLOCK, blockEnd(first + n), current[n]);
+      });
+
+      if(written.valid() && !written.get()) {
+
+        return false;
+      }
+
+      written = std::async(std::launch::async, [&sink, &current, count] {
+
+        for(size_t n = 0; n < count; ++n) {
+
+          if(!sink.write(current[n].data(), current[n].size())) {
+
+            return false;
+          }
+        }
+
+        return true;
+      });
+    }
+
+    return !written.valid() || written.get();
+  }
+
+  //writes the text of a string to a sink, the same text represent gives, false if the sink failed
+  template <typename Sink, typename T>
+  auto format(Sink& sink, const LString<T>& lstring, bool showParams = false, unsigned threads = 1) -> bool {
+
+    return formatBlocks(sink, lstring.size(), threads, [&](size_t first, size_t last, std::string& text) {
+
+      appendSymbols(text, lstring.data() + first, lstring.data() + last, showParams);
+    });
+  }
+
+  template <typename Sink, typename T, typename Hash>
+  auto format(Sink& sink, const LCompactString<T, Hash>& lstring, bool showParams = false, unsigned threads = 1) -> bool {
+
+    const auto texts = representations(lstring.registry());
+
+    return formatBlocks(sink, lstring.size(), threads, [&](size_t first, size_t last, std::string& text) {
+
+      appendSymbols(text, lstring, first, last, texts, showParams);
+    });
+  }
+}
+
+#endif
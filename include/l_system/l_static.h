@@ -0,0 +1,381 @@
+#ifndef L_SYSTEM_STATIC_H
+#define L_SYSTEM_STATIC_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "l_system/l_growth.h"
+
+namespace l_system {
+
+  //a rule known at compile time, rewriting every Predecessor into Successor..., such as LStaticRule<char, 'A', 'A', 'B'>
+  template <typename T, T Predecessor, T... Successor>
+  struct LStaticRule {
+
+    using type = T;
+
+    static constexpr T predecessor = Predecessor;
+    static constexpr size_t size = sizeof...(Successor);
+    static constexpr std::array<T, sizeof...(Successor)> successor = {Successor...};
+  };
+
+  template <typename T, T... Symbols>
+  struct LStaticAxiom {
+
+    using type = T;
+
+    static constexpr std::array<T, sizeof...(Symbols)> symbols = {Symbols...};
+  };
+
+  //a generation of a static system, the representation of each of its symbols, which have no parameters
+  template <typename T>
+  class LStaticString {
+
+    std::vector<T> symbols_;
+
+  public:
+
+    LStaticString() = default;
+
+    LStaticString(std::vector<T> symbols) noexcept : symbols_(std::move(symbols)) {}
+
+    auto begin() const noexcept {
+
+      return symbols_.begin();
+    }
+
+    auto end() const noexcept {
+
+      return symbols_.end();
+    }
+
+    auto size() const noexcept -> size_t {
+
+      return symbols_.size();
+    }
+
+    auto empty() const noexcept -> bool {
+
+      return symbols_.empty();
+    }
+
+    auto data() const noexcept -> const T* {
+
+      return symbols_.data();
+    }
+
+    auto operator[](size_t i) const noexcept -> T {
+
+      return symbols_[i];
+    }
+
+    auto symbol(size_t i) const -> LSymbol<T> {
+
+      return LSymbol<T>(LSymbolType<T>(symbols_[i]));
+    }
+
+    auto toLString() const -> LString<T> {
+
+      LString<T> result;
+      result.reserve(size());
+
+      for(auto representation : symbols_) {
+
+        result.emplace_back(LSymbolType<T>(representation));
+      }
+
+      return result;
+    }
+  };
+
+  //static strings have no parameters to show, showParams is taken for the same calls as an LString
+  template <typename T>
+  auto represent(const LStaticString<T>& lstring, bool showParams = false) -> std::string {
+
+    (void)showParams;
+
+    std::string out;
+
+    if constexpr (LCHARACTER_REPRESENTATION<T>) {
+
+      out.resize(lstring.size());
+
+      for(size_t i = 0; i < lstring.size(); ++i) {
+
+        out[i] = static_cast<char>(lstring[i]);
+      }
+    }
+    else {
+
+      for(auto representation : lstring) {
+
+        appendRepresentation(out, representation);
+      }
+    }
+
+    return out;
+  }
+
+  //a system whose axiom and rules are fixed at compile time, for single byte integral representations
+  //rules are compiled into a table of 256 successors, each padded to the longest one, so rewriting a symbol is one fixed size copy and an advance by its length
+  //where the successors of two symbols fit in a word, symbols are rewritten in pairs from a table of every pair
+  //as in LSystem, a later rule for a predecessor replaces an earlier one and symbols without a rule are kept
+  template <typename Axiom, typename... Rules>
+  class LStaticSystem {
+
+    using T = typename Axiom::type;
+    using Counts = std::array<LCount, 256>;
+
+    static_assert(std::is_integral_v<T> && sizeof(T) == 1, "static systems index their rules by byte.");
+    static_assert((std::is_same_v<typename Rules::type, T> && ...), "every rule must rewrite the axiom's representation.");
+
+    static constexpr auto index(T symbol) noexcept -> size_t {
+
+      return static_cast<unsigned char>(symbol);
+    }
+
+  public:
+
+    //the longest successor, the number of symbols copied for every symbol rewritten
+    static constexpr size_t WIDTH = std::max({size_t(1), Rules::size...});
+
+  private:
+
+    struct Table {
+
+      std::array<std::array<T, WIDTH>, 256> successors{};
+      std::array<size_t, 256> lengths{};
+    };
+
+    template <typename Rule>
+    static constexpr void apply(Table& table) noexcept {
+
+      const auto i = index(Rule::predecessor);
+
+      for(size_t n = 0; n < Rule::size; ++n) {
+
+        table.successors[i][n] = Rule::successor[n];
+      }
+
+      table.lengths[i] = Rule::size;
+    }
+
+    static constexpr auto build() noexcept -> Table {
+
+      Table table;
+
+      for(size_t i = 0; i < 256; ++i) {
+
+        table.successors[i][0] = static_cast<T>(i);
+        table.lengths[i] = 1;
+      }
+
+      (apply<Rules>(table), ...);
+
+      return table;
+    }
+
+    static constexpr Table TABLE = build();
+
+    //whether the successors of two symbols fit in one word, in which case symbols are rewritten two at a time
+    static constexpr bool PAIRED = 2 * WIDTH <= sizeof(std::uint64_t);
+
+    //room past the end of a buffer for the widest copy
+    static constexpr size_t SLACK = PAIRED ? sizeof(std::uint64_t) : WIDTH;
+
+    //the successors of both symbols of a pair, padded to a word
+    struct Pair {
+
+      std::uint64_t symbols;
+      std::uint64_t length;
+    };
+
+    //the successors of every pair of symbols, keyed by the two bytes as they lie in memory, built once on first use
+    static auto pairTable() -> const std::vector<Pair>& {
+
+      static const std::vector<Pair> pairs = [] {
+
+        std::vector<Pair> result(1 << 16);
+
+        for(size_t first = 0; first < 256; ++first) {
+
+          for(size_t second = 0; second < 256; ++second) {
+
+            const unsigned char bytes[2] = {static_cast<unsigned char>(first), static_cast<unsigned char>(second)};
+            T symbols[sizeof(std::uint64_t)] = {};
+            std::uint16_t key;
+
+            memcpy(&key, bytes, sizeof(key));
+            memcpy(symbols, TABLE.successors[first].data(), TABLE.lengths[first] * sizeof(T));
+            memcpy(symbols + TABLE.lengths[first], TABLE.successors[second].data(), TABLE.lengths[second] * sizeof(T));
+
+            result[key].length = TABLE.lengths[first] + TABLE.lengths[second];
+            memcpy(&result[key].symbols, symbols, sizeof(symbols));
+          }
+        }
+
+        return result;
+      }();
+
+      return pairs;
+    }
+
+    //the symbol counts of the generation after counts
+    static constexpr auto step(const Counts& counts) noexcept -> Counts {
+
+      Counts next{};
+
+      for(size_t i = 0; i < 256; ++i) {
+
+        if(counts[i] == 0) {
+
+          continue;
+        }
+
+        for(size_t n = 0; n < TABLE.lengths[i]; ++n) {
+
+          auto& count = next[index(TABLE.successors[i][n])];
+
+          count = saturatingAdd(count, counts[i]);
+        }
+      }
+
+      return next;
+    }
+
+    static constexpr auto total(const Counts& counts) noexcept -> LCount {
+
+      LCount sum = 0;
+
+      for(auto count : counts) {
+
+        sum = saturatingAdd(sum, count);
+      }
+
+      return sum;
+    }
+
+    static constexpr auto axiomCounts() noexcept -> Counts {
+
+      Counts counts{};
+
+      for(auto symbol : Axiom::symbols) {
+
+        ++counts[index(symbol)];
+      }
+
+      return counts;
+    }
+
+  public:
+
+    //the number of symbols a representation rewrites to in one generation
+    static constexpr auto successorLength(T symbol) noexcept -> size_t {
+
+      return TABLE.lengths[index(symbol)];
+    }
+
+    //how often each representation occurs in a generation, saturating at LCOUNT_OVERFLOW
+    static constexpr auto counts(int generations) noexcept -> Counts {
+
+      auto counts = axiomCounts();
+
+      for(int i = 0; i < generations; ++i) {
+
+        counts = step(counts);
+      }
+
+      return counts;
+    }
+
+    //the length of a generation, computed without generating it, usable in constant expressions
+    static constexpr auto length(int generations) noexcept -> LCount {
+
+      return total(counts(generations));
+    }
+
+    //the same system built at runtime, for whatever needs an LSystem
+    static auto toSystem() -> LSystem<T> {
+
+      LString<T> axiom;
+
+      for(auto symbol : Axiom::symbols) {
+
+        axiom.emplace_back(LSymbolType<T>(symbol));
+      }
+
+      LSystem<T> system(axiom);
+
+      (system.addRule(LRule<T>(LSymbolType<T>(Rules::predecessor), LTypeString<T>(Rules::successor.begin(), Rules::successor.end()))), ...);
+
+      return system;
+    }
+
+    //throws std::length_error if a generation along the way is too long to be held, as its length then saturates
+    static auto generate(int generations) -> LStaticString<T> {
+
+      //both buffers hold the longest generation along the way, and room for a whole successor copied past its end
+      auto counts = axiomCounts();
+      auto longest = total(counts);
+
+      for(int i = 0; i < generations; ++i) {
+
+        counts = step(counts);
+        longest = std::max(longest, total(counts));
+      }
+
+      std::vector<T> current(bufferSize<T>(longest, SLACK));
+      std::vector<T> next(current.size());
+
+      std::copy(Axiom::symbols.begin(), Axiom::symbols.end(), current.begin());
+
+      auto size = Axiom::symbols.size();
+
+      for(int i = 0; i < generations; ++i) {
+
+        auto* out = next.data();
+        size_t n = 0;
+
+        if constexpr (PAIRED) {
+
+          const auto& pairs = pairTable();
+
+          for(; n + 2 <= size; n += 2) {
+
+            std::uint16_t key;
+            memcpy(&key, current.data() + n, sizeof(key));
+
+            const auto& pair = pairs[key];
+
+            memcpy(out, &pair.symbols, sizeof(pair.symbols));
+            out += pair.length;
+          }
+        }
+
+        for(; n < size; ++n) {
+
+          const auto symbol = index(current[n]);
+
+          memcpy(out, TABLE.successors[symbol].data(), WIDTH * sizeof(T));
+          out += TABLE.lengths[symbol];
+        }
+
+        size = static_cast<size_t>(out - next.data());
+        std::swap(current, next);
+      }
+
+      current.resize(size);
+
+      return LStaticString<T>(std::move(current));
+    }
+  };
+}
+
+#endif
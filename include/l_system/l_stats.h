@@ -0,0 +1,33 @@
+#ifndef L_SYSTEM_STATS_H
+#define L_SYSTEM_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace l_system {
+
+  //what rewriting one generation cost, recorded by a system while statistics are collected
+  struct LGenerationStats {
+
+    int generation = 0; //the generation produced
+    double seconds = 0.0; //wall time of the rewrite, without the time taken to gather these statistics
+    size_t inputSymbols = 0;
+    size_t outputSymbols = 0;
+    size_t bufferAllocations = 0; //times the output buffer had to grow
+    std::uint64_t allocations = 0; //heap allocations seen by the system's allocation counter, 0 without one
+    size_t bytesMoved = 0; //symbol and parameter bytes written to the output
+    size_t peakBufferBytes = 0; //the most symbol storage the input and output buffers held at once
+    std::vector<size_t> ruleHits; //rule index -> symbols it rewrote
+    std::vector<size_t> ruleOutput; //rule index -> symbols it produced
+    size_t kept = 0; //symbols no rule rewrote
+
+    //how many times longer the output is than the input
+    auto growth() const noexcept -> double {
+
+      return (inputSymbols == 0) ? 0.0 : static_cast<double>(outputSymbols) / static_cast<double>(inputSymbols);
+    }
+  };
+}
+
+#endif
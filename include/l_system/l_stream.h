@@ -0,0 +1,143 @@
+#ifndef L_SYSTEM_STREAM_H
+#define L_SYSTEM_STREAM_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "l_system/l_dispatch.h"
+
+namespace l_system {
+
+  //a lazy, single pass view of one generation of a system, expanded depth first from the axiom
+  //only a stack of one cursor per generation is held, so memory is linear in the generation rather than the output length
+  //the stream refers to the system's axiom and compiled rules, and is invalidated by modifying the system
+  template <typename T, typename Hash = std::hash<T>>
+  class LStream {
+
+    const LRuleTable<T, Hash>* table_;
+    const LString<T>* axiom_;
+    int generations_;
+
+  public:
+
+    class iterator {
+
+      struct Cursor {
+
+        const LSymbol<T>* position;
+        const LSymbol<T>* end;
+      };
+
+      const LRuleTable<T, Hash>* table_ = nullptr;
+      int generations_ = 0;
+      std::vector<Cursor> stack_; //stack_[d] walks a successor string of generation d, empty once exhausted
+
+      //descends from the current position until it rests on a symbol of the final generation
+      //a symbol without a rule is its own successor forever, so it is yielded without descending further
+      void settle() noexcept {
+
+        while(!stack_.empty()) {
+
+          auto& top = stack_.back();
+
+          if(top.position == top.end) {
+
+            stack_.pop_back();
+
+            if(!stack_.empty()) {
+
+              ++stack_.back().position;
+            }
+
+            continue;
+          }
+
+          if(stack_.size() > static_cast<size_t>(generations_)) {
+
+            return;
+          }
+
+          auto rule = table_->find(top.position->type());
+
+          if(rule == NO_RULE) {
+
+            return;
+          }
+
+          const auto& successor = table_->successor(rule);
+
+          stack_.push_back({successor.data(), successor.data() + successor.size()});
+        }
+      }
+
+    public:
+
+      using iterator_category = std::input_iterator_tag;
+      using value_type = LSymbol<T>;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const LSymbol<T>*;
+      using reference = const LSymbol<T>&;
+
+      iterator() = default;
+
+      //a negative number of generations yields the axiom, as generate does
+      iterator(const LRuleTable<T, Hash>& table, const LString<T>& axiom, int generations) : table_(&table), generations_(std::max(0, generations)) {
+
+        stack_.reserve(static_cast<size_t>(generations_) + 1);
+        stack_.push_back({axiom.data(), axiom.data() + axiom.size()});
+
+        settle();
+      }
+
+      auto operator*() const noexcept -> reference {
+
+        return *stack_.back().position;
+      }
+
+      auto operator->() const noexcept -> pointer {
+
+        return stack_.back().position;
+      }
+
+      auto operator++() noexcept -> iterator& {
+
+        ++stack_.back().position;
+        settle();
+
+        return *this;
+      }
+
+      void operator++(int) noexcept {
+
+        ++*this;
+      }
+
+      //iterators only compare equal when both are exhausted
+      bool operator==(const iterator& other) const noexcept {
+
+        return stack_.empty() && other.stack_.empty();
+      }
+
+      bool operator!=(const iterator& other) const noexcept {
+
+        return !(*this == other);
+      }
+    };
+
+    LStream(const LRuleTable<T, Hash>& table, const LString<T>& axiom, int generations) : table_(&table), axiom_(&axiom), generations_(std::max(0, generations)) {}
+
+    auto begin() const -> iterator {
+
+      return iterator(*table_, *axiom_, generations_);
+    }
+
+    auto end() const noexcept -> iterator {
+
+      return iterator();
+    }
+  };
+}
+
+#endif
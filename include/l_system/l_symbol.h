@@ -1,7 +1,12 @@
 #ifndef L_SYSTEM_SYMBOL_H
 #define L_SYSTEM_SYMBOL_H
 
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
 #include "l_system/l_param.h"
+#include "l_system/l_format.h"
 
 namespace l_system {
 
@@ -48,6 +53,8 @@ namespace l_system {
   template <typename T>
   using LTypeString = std::vector<LSymbolType<T>>;
 
+  //a symbol's parameters come from the default memory resource, or from the resource of an allocator it is constructed with
+  //symbols are allocator aware, a std::pmr container of them gives each its own resource
   template <typename T>
   class LSymbol {
 
@@ -55,8 +62,25 @@ namespace l_system {
     LParameterData parameters_;
 
   public:
+
+    using allocator_type = LParameterData::allocator_type;
+
     LSymbol(LSymbolType<T> type = LSymbolType<T>()) : type_(type), parameters_(type.paramSet(), type.customParamSize()) {}
 
+    LSymbol(std::allocator_arg_t, const allocator_type& allocator, LSymbolType<T> type = LSymbolType<T>()) : type_(type), parameters_(type.paramSet(), type.customParamSize(), allocator) {}
+
+    LSymbol(std::allocator_arg_t, const allocator_type& allocator, const LSymbol& other) : type_(other.type_), parameters_(other.parameters_, allocator) {}
+
+    LSymbol(const LSymbol& other) = default;
+    LSymbol(LSymbol&& other) noexcept = default;
+    auto operator=(const LSymbol& other) -> LSymbol& = default;
+    auto operator=(LSymbol&& other) -> LSymbol& = default;
+
+    auto get_allocator() const noexcept -> allocator_type {
+
+      return parameters_.get_allocator();
+    }
+
     auto type() const noexcept -> LSymbolType<T> {
 
       return type_;
@@ -72,6 +96,16 @@ namespace l_system {
       return type_.customParamSize();
     }
 
+    auto parameters() const noexcept -> const LParameterData& {
+
+      return parameters_;
+    }
+
+    auto parameters() noexcept -> LParameterData& {
+
+      return parameters_;
+    }
+
     auto getCharParam(LParameterCount n) const noexcept -> char {
 
       return parameters_.getChar(n);
@@ -116,41 +150,104 @@ namespace l_system {
   template <typename T>
   using LString = std::vector<LSymbol<T>>;
 
+  namespace pmr {
+
+    //a string whose symbols and their parameters all come from one memory resource
+    template <typename T>
+    using LString = std::vector<LSymbol<T>, std::pmr::polymorphic_allocator<LSymbol<T>>>;
+  }
+
+  //writes one symbol, anything with the accessors of LSymbol can be written
+  template <typename S>
+  void representSymbol(std::ostream& stream, const S& symbol, bool showParams) {
+
+    stream << symbol.type().representation();
+
+    if(!empty(symbol.paramSet()) && showParams) {
+
+      stream << '(';
+
+      for(LParameterCount i = 0; i < parameterCount(symbol.paramSet(), LCHAR); ++i) {
+
+        stream << symbol.getCharParam(i) << ' ';
+      }
+      for(LParameterCount i = 0; i < parameterCount(symbol.paramSet(), LINT); ++i) {
+
+        stream << symbol.getIntParam(i) << ' ';
+      }
+      for(LParameterCount i = 0; i < parameterCount(symbol.paramSet(), LFLOAT); ++i) {
+
+        stream << symbol.getFloatParam(i) << ' ';
+      }
+      for(LParameterCount i = 0; i < parameterCount(symbol.paramSet(), LCUSTOM); ++i) {
+
+        stream << represent(symbol.getCustomParam(i), false) << ' ';
+      }
+
+      stream << ')';
+    }
+  }
+
+  //appends the text representSymbol writes for one symbol, without a stream
   template <typename T>
-  auto represent(const LString<T>& lstring, bool showParams = false) noexcept -> std::string {
+  void appendSymbol(std::string& out, const LSymbol<T>& symbol, bool showParams) {
 
-    std::ostringstream stream;
+    appendRepresentation(out, symbol.type().representation());
 
-    for(LSymbol<T> symbol : lstring) {
+    if(!empty(symbol.paramSet()) && showParams) {
 
-      stream << symbol.type().representation();
+      appendParameters(out, symbol.paramSet(), symbol.customParamSize(), symbol.parameters().data());
+    }
+  }
 
-      if(!empty(symbol.paramSet()) && showParams) {
+  //appends the text of the symbols [first, last), characters without parameters are stored straight into the text
+  template <typename T>
+  void appendSymbols(std::string& out, const LSymbol<T>* first, const LSymbol<T>* last, bool showParams) {
 
-        stream << '(';
+    if constexpr (LCHARACTER_REPRESENTATION<T>) {
 
-        for(LParameterCount i = 0; i < parameterCount(symbol.paramSet(), LCHAR); ++i) {
+      if(!showParams) {
 
-          stream << symbol.getCharParam(i) << ' ';
-        }
-        for(LParameterCount i = 0; i < parameterCount(symbol.paramSet(), LINT); ++i) {
+        const auto size = out.size();
 
-          stream << symbol.getIntParam(i) << ' ';
-        }
-        for(LParameterCount i = 0; i < parameterCount(symbol.paramSet(), LFLOAT); ++i) {
+        out.resize(size + static_cast<size_t>(last - first));
 
-          stream << symbol.getFloatParam(i) << ' ';
-        }
-        for(LParameterCount i = 0; i < parameterCount(symbol.paramSet(), LCUSTOM); ++i) {
+        auto* text = out.data() + size;
 
-          stream << represent(symbol.getCustomParam(i), false) << ' ';
+        for(; first != last; ++first) {
+
+          *text++ = static_cast<char>(first->type().representation());
         }
 
-        stream << ')';
+        return;
       }
     }
 
-    return stream.str();
+    for(; first != last; ++first) {
+
+      appendSymbol(out, *first, showParams);
+    }
+  }
+
+  //the text of a string, the same as writing each symbol with representSymbol
+  template <typename T>
+  auto represent(const LString<T>& lstring, bool showParams = false) noexcept -> std::string {
+
+    std::string result;
+
+    appendSymbols(result, lstring.data(), lstring.data() + lstring.size(), showParams);
+
+    return result;
+  }
+
+  template <typename T>
+  auto represent(const pmr::LString<T>& lstring, bool showParams = false) noexcept -> std::string {
+
+    std::string result;
+
+    appendSymbols(result, lstring.data(), lstring.data() + lstring.size(), showParams);
+
+    return result;
   }
 
   template <typename T>
@@ -1,33 +1,671 @@
 #ifndef L_SYSTEM_H
 #define L_SYSTEM_H
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <unordered_map>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <ostream>
 #include <set>
+#include <type_traits>
+#include <utility>
 
 #include "l_system/l_param.h"
 #include "l_system/l_rule.h"
+#include "l_system/l_dispatch.h"
+#include "l_system/l_parallel.h"
+#include "l_system/l_stream.h"
+#include "l_system/l_binary.h"
+#include "l_system/l_disk.h"
+#include "l_system/l_sink.h"
+#include "l_system/l_stats.h"
+#include "l_system/l_arena.h"
 
 namespace l_system {
 
-  template <typename T>
+  //Hash is used to intern symbol types whose representation is not a small integral type
+  //without a usable Hash, such types are found by scanning the distinct types of the rules
+  template <typename T, typename Hash = std::hash<T>>
   class LSystem {
 
     LString<T> axiom_;
     std::vector<LRule<T>> rules_;
+    LContextOptions<T> context_;
+    //rules_ compiled for lookup, marked stale by every change to the rules or context options and rebuilt once by the next compiled()
+    //the rebuild is locked, so that threads generating from a system left unchanged since are safe to race on it
+    struct Compiled {
+
+      LRuleTable<T, Hash> table;
+      std::atomic<bool> stale{true};
+      mutable std::mutex mutex; //guards rebuilding table, and copying it
+
+      Compiled() = default;
+
+      Compiled(const Compiled& other) {
+
+        *this = other;
+      }
+
+      auto operator=(const Compiled& other) -> Compiled& {
+
+        if(this != &other) {
+
+          const std::scoped_lock lock(mutex, other.mutex);
+
+          table = other.table;
+          stale.store(other.stale.load());
+        }
+
+        return *this;
+      }
+    };
+
+    mutable Compiled compiled_;
+    std::uint64_t seed_ = 0; //keys the draws of stochastic rules
+    //written by the const generate calls while caching is on, unguarded, so a caching system must not generate from several threads at once
+    mutable std::map<int, LString<T>> cache_; //generation -> generated string, shallowest generations are evicted first
+    mutable size_t cacheSize_ = 0; //bytes held by cache_, symbols and their parameter data
+    size_t cacheLimit_ = 0; //caching is off while this is 0
+    bool statsEnabled_ = false;
+    mutable std::vector<LGenerationStats> stats_; //one record per generation rewritten while enabled
+    std::function<void(const LGenerationStats&)> onGeneration_;
+    std::function<std::uint64_t()> allocationCounter_;
+
+    static auto footprint(const LString<T>& lstring) noexcept -> size_t {
+
+      auto bytes = lstring.size() * sizeof(LSymbol<T>);
+
+      for(const auto& symbol : lstring) {
+
+        bytes += symbol.parameters().size();
+      }
+
+      return bytes;
+    }
+
+    //keeps a copy of a generation if it fits under the cache limit, evicting shallower generations to make room
+    void cache(int generation, const LString<T>& lstring) const {
+
+      const auto size = footprint(lstring);
+
+      if(size > cacheLimit_ || cache_.count(generation) != 0) {
+
+        return;
+      }
+
+      while(cacheSize_ + size > cacheLimit_ && !cache_.empty() && cache_.begin()->first < generation) {
+
+        cacheSize_ -= footprint(cache_.begin()->second);
+        cache_.erase(cache_.begin());
+      }
+
+      if(cacheSize_ + size <= cacheLimit_) {
+
+        cache_.emplace(generation, lstring);
+        cacheSize_ += size;
+      }
+    }
+
+    //the deepest cached generation at or below a generation, falling back to the axiom
+    auto closestCached(int generation) const noexcept -> std::pair<int, const LString<T>*> {
+
+      auto found = cache_.upper_bound(generation);
+
+      if(found == cache_.begin()) {
+
+        return {0, &axiom_};
+      }
+
+      --found;
+
+      return {found->first, &found->second};
+    }
+
+    //rewrites size symbols from source into next by counting the exact output length, filling the buffer in place, then computing parameters set by expressions
+    //large ranges are split into chunks whose output positions come from a prefix sum of their lengths
+    //stochastic rules draw by position from key, whose position is that of source, so the chunking does not change the result
+    //next is an LString or a pmr::LString, whose new symbols then take their parameter storage from its resource
+    template <typename String>
+    static void step(const LRuleTable<T, Hash>& table, const LSymbol<T>* source, size_t size, String& next, unsigned threads, LRandomKey key) {
+
+      const auto chunks = usefulThreads(size, threads);
+
+      //context sensitive and guarded rules are matched for the whole range up front, in linear passes
+      const auto matched = table.conditional() ? table.match(source, source + size) : std::vector<LRuleIndex>();
+      const auto* rules = table.conditional() ? matched.data() : nullptr;
+
+      if(chunks == 1) {
+
+        const auto length = table.rewrittenLength(source, source + size, rules, key);
+
+        if constexpr (std::is_default_constructible_v<T>) {
+
+          next.resize(length);
+          table.rewrite(source, source + size, next.data(), rules, key);
+        }
+        else {
+
+          next.clear();
+          next.reserve(length);
+          table.rewrite(source, source + size, std::back_inserter(next), rules, key);
+        }
+
+        table.parameterize(source, source + size, next.data(), rules, key);
+
+        return;
+      }
+
+      std::vector<size_t> offsets(chunks + 1, 0);
+
+      const auto chunkRules = [&](size_t n) { return (rules == nullptr) ? nullptr : rules + chunkBegin(size, chunks, n); };
+      const auto chunkKey = [&](size_t n) { return LRandomKey{key.seed, key.generation, key.position + chunkBegin(size, chunks, n)}; };
+
+      //each thread counts its chunk, waits for the output to be sized from their sum, and fills the same chunk, so threads are started once per step
+      parallelPhases(chunks, [&](size_t n) {
+
+        offsets[n + 1] = table.rewrittenLength(source + chunkBegin(size, chunks, n), source + chunkBegin(size, chunks, n + 1), chunkRules(n), chunkKey(n));
+      },
+      [&]() {
+
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        //only symbols past what next already holds are constructed, the rest are assigned over in place by their chunk's thread
+        if constexpr (std::is_default_constructible_v<T>) {
+
+          next.resize(offsets.back());
+        }
+        else {
+
+          next.resize(offsets.back(), source[0]); //placeholder symbols, all of them are overwritten below
+        }
+      },
+      [&](size_t n) {
+
+        table.rewrite(source + chunkBegin(size, chunks, n), source + chunkBegin(size, chunks, n + 1), next.data() + offsets[n], chunkRules(n), chunkKey(n));
+        table.parameterize(source + chunkBegin(size, chunks, n), source + chunkBegin(size, chunks, n + 1), next.data() + offsets[n], chunkRules(n), chunkKey(n));
+      });
+    }
+
+    template <typename String>
+    static void step(const LRuleTable<T, Hash>& table, const String& current, String& next, unsigned threads, LRandomKey key) {
+
+      step(table, current.data(), current.size(), next, threads, key);
+    }
+
+    //the most symbols any production rewrites one symbol into, at least 1
+    auto longestSuccessor() const noexcept -> size_t {
+
+      size_t longest = 1;
+
+      for(const auto& rule : rules_) {
+
+        for(const auto& alternative : rule.alternatives()) {
+
+          longest = std::max(longest, alternative.result.size());
+        }
+      }
+
+      return longest;
+    }
+
+    //the symbols of a chunk generating on disk keeps within budget bytes, each counted as the largest symbol of the system with its parameter data
+    //two chunks are read or rewritten while two are rewritten into or written
+    auto chunkCapacity(size_t budget) const -> size_t {
+
+      size_t largest = 0;
+
+      for(const auto& type : getAllSymbolTypes()) {
+
+        largest = std::max<size_t>(largest, requiredDataSize(type.paramSet(), type.customParamSize()));
+      }
+
+      return std::max<size_t>(1, budget / (4 * (sizeof(LSymbol<T>) + largest)));
+    }
+
+    //rewrites the generation in from generation by generation up to generations, each into chunk files in directory
+    //input chunks hold at most capacity symbols and are split into pieces which can not rewrite to more than capacity symbols
+    //each piece is keyed by its position in the whole generation, so the result matches generating in memory
+    //generations written along the way are deleted once rewritten, the one in from is kept
+    //context sensitive rules are refused, as contexts are not matched across pieces
+    auto rewriteOnDisk(const LDiskString<T, Hash>& from, int generations, const std::string& directory, size_t capacity, unsigned threads) const -> std::optional<LDiskString<T, Hash>> {
+
+      const auto& table = compiled();
+
+      if(table.contextSensitive()) {
+
+        return std::nullopt;
+      }
+
+      const auto piece = std::max<size_t>(1, capacity / longestSuccessor());
+      auto current = from;
+
+      LString<T> input;
+      LString<T> output;
+
+      for(int i = from.generation(); i < generations; ++i) {
+
+        LChunkReader<T, Hash> reader(current);
+        LChunkWriter<T, Hash> writer(directory, i + 1);
+        std::uint64_t position = 0;
+        LGenerationStats record;
+
+        record.generation = i + 1;
+
+        while(reader.next(input)) {
+
+          for(size_t begin = 0; begin < input.size(); begin += piece) {
+
+            const auto size = std::min(piece, input.size() - begin);
+            const LRandomKey key = {seed_, static_cast<std::uint64_t>(i), position};
+
+            if(collecting()) {
+
+              measuredStep(table, input.data() + begin, size, output, threads, key, record);
+              record.peakBufferBytes = std::max(record.peakBufferBytes, (input.capacity() + output.capacity()) * sizeof(LSymbol<T>));
+            }
+            else {
+
+              step(table, input.data() + begin, size, output, threads, key);
+            }
+
+            writer.write(output);
+            position += size;
+          }
+        }
+
+        auto next = writer.finish();
+
+        if(reader.failed() || !next) {
+
+          return std::nullopt;
+        }
+
+        if(collecting()) {
+
+          publish(std::move(record));
+        }
+
+        if(i != from.generation()) {
+
+          current.remove();
+        }
+
+        current = std::move(*next);
+      }
+
+      return current;
+    }
+
+    //whether rewriting gathers statistics, checked once per generation so that nothing is gathered or timed otherwise
+    auto collecting() const noexcept -> bool {
+
+      return statsEnabled_ || onGeneration_;
+    }
+
+    //rewrites a range with step, adding what it cost to record
+    //the rules chosen are found again for the tally, after the rewrite is timed
+    template <typename String>
+    void measuredStep(const LRuleTable<T, Hash>& table, const LSymbol<T>* source, size_t size, String& next, unsigned threads, LRandomKey key, LGenerationStats& record) const {
+
+      //growth is taken on the buffer step writes, on disk that is whichever of the writer's two buffers it handed back last
+      const auto* buffer = next.data();
+      const auto capacity = next.capacity();
+      const auto allocated = allocationCounter_ ? allocationCounter_() : 0;
+      const auto start = std::chrono::steady_clock::now();
+
+      step(table, source, size, next, threads, key);
+
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+      record.seconds += elapsed.count();
+      record.allocations += allocationCounter_ ? allocationCounter_() - allocated : 0;
+      record.bufferAllocations += (next.data() != buffer || next.capacity() != capacity) ? 1u : 0u;
+      record.inputSymbols += size;
+      record.outputSymbols += next.size();
+
+      const auto matched = table.conditional() ? table.match(source, source + size) : std::vector<LRuleIndex>();
+
+      table.tally(source, source + size, table.conditional() ? matched.data() : nullptr, key, record);
+    }
+
+    //rewrites generation into next, recording statistics if they are collected
+    template <typename String>
+    void advance(const LRuleTable<T, Hash>& table, const String& current, String& next, unsigned threads, int generation) const {
+
+      const LRandomKey key = {seed_, static_cast<std::uint64_t>(generation), 0};
+
+      if(!collecting()) {
+
+        step(table, current, next, threads, key);
+        return;
+      }
+
+      LGenerationStats record;
+      record.generation = generation + 1;
+
+      measuredStep(table, current.data(), current.size(), next, threads, key, record);
+      record.peakBufferBytes = (current.capacity() + next.capacity()) * sizeof(LSymbol<T>);
+
+      publish(std::move(record));
+    }
+
+    void publish(LGenerationStats record) const {
+
+      if(onGeneration_) {
+
+        onGeneration_(record);
+      }
+
+      if(statsEnabled_) {
+
+        stats_.emplace_back(std::move(record));
+      }
+    }
+
+    //writes the system and the given generations, header first, then the context options, axiom, rules and generations
+    auto write(std::ostream& out, const std::vector<std::pair<int, const LString<T>*>>& generations) const -> bool {
+
+      LBinaryWriter writer(out);
+
+      writer.bytes("LSYS", 4);
+      writer.value(LBINARY_VERSION);
+      writer.value(LBINARY_BYTE_ORDER);
+      writer.value(static_cast<std::uint32_t>(sizeof(T)));
+      writer.value(seed_);
+      writer.value<std::uint64_t>(cacheLimit_);
+
+      for(const auto& branch : {context_.push, context_.pop}) {
+
+        writer.value(static_cast<std::uint64_t>(branch ? 1 : 0));
+
+        if(branch) {
+
+          writeType(writer, *branch);
+        }
+      }
+
+      writeTypes(writer, context_.ignored);
+      writeString<T, Hash>(writer, axiom_);
+      writer.value<std::uint64_t>(rules_.size());
+
+      for(const auto& rule : rules_) {
+
+        writeRule(writer, rule);
+      }
+
+      writer.value<std::uint64_t>(generations.size());
+
+      for(const auto& [generation, lstring] : generations) {
+
+        writer.value(static_cast<std::int64_t>(generation));
+        writeString<T, Hash>(writer, *lstring);
+      }
+
+      return writer.good();
+    }
 
   public:
 
+    //the rule table is built by the first compiled() after a change, so adding rules one by one rebuilds it once rather than per rule
     LSystem(LString<T> axiom) : axiom_(axiom) {}
+
     LSystem(std::initializer_list<LSymbol<T>> axiom) : axiom_(axiom) {}
 
-    void addRule(LRule<T> rule) noexcept {
+    void addRule(LRule<T> rule) {
 
       rules_.emplace_back(rule);
+      compiled_.stale = true;
+      clearCache();
     }
 
     void setAxiom(const LString<T>& axiom) noexcept {
 
       axiom_ = axiom;
+      clearCache();
+    }
+
+    //sets the symbols which open and close branches, which context sensitive rules look across
+    void setBranchSymbols(const LSymbolType<T>& push, const LSymbolType<T>& pop) {
+
+      context_.push = push;
+      context_.pop = pop;
+      compiled_.stale = true;
+      clearCache();
+    }
+
+    //makes context sensitive rules look through a symbol type, as if it were not there
+    void ignoreInContext(const LSymbolType<T>& type) {
+
+      context_.ignored.emplace_back(type);
+      compiled_.stale = true;
+      clearCache();
+    }
+
+    //sets the seed stochastic rules draw from, each (seed, generation, position) always draws the same successor
+    void setSeed(std::uint64_t seed) noexcept {
+
+      seed_ = seed;
+      clearCache();
+    }
+
+    auto seed() const noexcept -> std::uint64_t {
+
+      return seed_;
+    }
+
+    //lets generate and generateSeries keep generations up to a total of roughly bytes, and continue from the deepest one kept
+    //cached generations are dropped whenever the axiom or rules change, a limit of 0 turns caching off
+    //with caching on, a system must not generate from several threads at once
+    void setCacheLimit(size_t bytes) noexcept {
+
+      cacheLimit_ = bytes;
+
+      while(cacheSize_ > cacheLimit_) {
+
+        cacheSize_ -= footprint(cache_.begin()->second);
+        cache_.erase(cache_.begin());
+      }
+    }
+
+    //records what each generation rewritten by generate, generateSeries and generateOnDisk costs, from here on
+    //while off, which it is by default, generating neither times nor counts anything
+    void enableStats(bool enabled = true) noexcept {
+
+      statsEnabled_ = enabled;
+    }
+
+    //the generations recorded since statistics were enabled or last cleared, in the order they were rewritten
+    auto stats() const noexcept -> const std::vector<LGenerationStats>& {
+
+      return stats_;
+    }
+
+    void clearStats() noexcept {
+
+      stats_.clear();
+    }
+
+    //calls callback with each generation's statistics as soon as it is rewritten, whether or not stats keeps them
+    //statistics are gathered while a callback is set, an empty callback removes it
+    //the callback runs on the generating thread, between generations
+    void setGenerationCallback(std::function<void(const LGenerationStats&)> callback) {
+
+      onGeneration_ = std::move(callback);
+    }
+
+    //counts heap allocations for the statistics, counter returns a running total such as one kept by a replaced operator new
+    void setAllocationCounter(std::function<std::uint64_t()> counter) {
+
+      allocationCounter_ = std::move(counter);
+    }
+
+    auto cacheLimit() const noexcept -> size_t {
+
+      return cacheLimit_;
+    }
+
+    void clearCache() const noexcept {
+
+      cache_.clear();
+      cacheSize_ = 0;
+    }
+
+    //saves the axiom, rules, context options, seed, cache limit and every cached generation in the binary format
+    //a loaded system goes on from the deepest saved generation, so a checkpoint is just a saved cache
+    auto save(std::ostream& out) const -> bool {
+
+      std::vector<std::pair<int, const LString<T>*>> generations;
+
+      for(const auto& [generation, lstring] : cache_) {
+
+        generations.emplace_back(generation, &lstring);
+      }
+
+      return write(out, generations);
+    }
+
+    //saves the system along with one generation as its checkpoint, whether or not the generation is cached
+    auto save(std::ostream& out, int generation, const LString<T>& lstring) const -> bool {
+
+      return write(out, {{generation, &lstring}});
+    }
+
+    //reads a system saved by save, or nothing if the stream does not hold one written by this version on a machine like this one
+    //the saved generations are put into the cache, even beyond its limit, for generate and generateSeries to continue from
+    static auto load(std::istream& in) -> std::optional<LSystem> {
+
+      const std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+      LBinaryReader reader(bytes.data(), bytes.size());
+
+      const auto* magic = reader.bytes(4);
+      const auto version = reader.value<std::uint32_t>();
+      const auto byteOrder = reader.value<std::uint32_t>();
+      const auto representationSize = reader.value<std::uint32_t>();
+      const auto seed = reader.value<std::uint64_t>();
+      const auto cacheLimit = reader.value<std::uint64_t>();
+
+      if(reader.failed() || memcmp(magic, "LSYS", 4) != 0 || version != LBINARY_VERSION || byteOrder != LBINARY_BYTE_ORDER || representationSize != sizeof(T)) {
+
+        return std::nullopt;
+      }
+
+      std::optional<LSymbolType<T>> branches[2];
+
+      for(auto& branch : branches) {
+
+        if(reader.value<std::uint64_t>() != 0 && !(branch = readType<T>(reader))) {
+
+          return std::nullopt;
+        }
+      }
+
+      //symbols are matched by representation alone, so every type of a representation must have the same parameters
+      //a rule's compiled expressions would otherwise read outside of the parameters of the symbols it matches
+      std::set<LSymbolType<T>> layouts;
+
+      const auto agrees = [&layouts](const LSymbolType<T>& type) {
+
+        const auto [layout, inserted] = layouts.insert(type);
+
+        return inserted || (layout->paramSet() == type.paramSet() && layout->customParamSize() == type.customParamSize());
+      };
+
+      const auto registryAgrees = [&agrees](const LSymbolRegistry<T, Hash>& registry) {
+
+        for(LSymbolId id = 0; id < registry.size(); ++id) {
+
+          if(!agrees(registry.type(id))) {
+
+            return false;
+          }
+        }
+
+        return true;
+      };
+
+      const auto ignored = readTypes<T>(reader);
+      const auto axiom = LMappedString<T, Hash>::parse(reader, nullptr);
+
+      if(!ignored || !axiom || !registryAgrees(axiom->registry())) {
+
+        return std::nullopt;
+      }
+
+      LSystem system(axiom->toLString());
+
+      if(branches[0] && branches[1]) {
+
+        system.setBranchSymbols(*branches[0], *branches[1]);
+      }
+
+      for(const auto& type : *ignored) {
+
+        system.ignoreInContext(type);
+      }
+
+      const auto ruleCount = reader.value<std::uint64_t>();
+
+      for(std::uint64_t i = 0; i < ruleCount && !reader.failed(); ++i) {
+
+        auto rule = readRule<T>(reader);
+
+        if(!rule || !agrees(rule->predecessor())) {
+
+          return std::nullopt;
+        }
+
+        for(const auto* types : {&rule->left(), &rule->right()}) {
+
+          if(!std::all_of(types->begin(), types->end(), agrees)) {
+
+            return std::nullopt;
+          }
+        }
+
+        for(const auto& alternative : rule->alternatives()) {
+
+          if(!std::all_of(alternative.result.begin(), alternative.result.end(), agrees)) {
+
+            return std::nullopt;
+          }
+        }
+
+        system.addRule(*rule);
+      }
+
+      system.setSeed(seed);
+      system.setCacheLimit(static_cast<size_t>(cacheLimit));
+
+      const auto generationCount = reader.value<std::uint64_t>();
+
+      for(std::uint64_t i = 0; i < generationCount && !reader.failed(); ++i) {
+
+        const auto generation = reader.value<std::int64_t>();
+        const auto lstring = LMappedString<T, Hash>::parse(reader, nullptr);
+
+        if(!lstring || !registryAgrees(lstring->registry()) || generation < 0 || generation > std::numeric_limits<int>::max()) {
+
+          return std::nullopt;
+        }
+
+        system.cacheSize_ += footprint(system.cache_[static_cast<int>(generation)] = lstring->toLString());
+      }
+
+      if(reader.failed()) {
+
+        return std::nullopt;
+      }
+
+      return system;
     }
 
     auto axiom() const noexcept -> LString<T> {
@@ -40,41 +678,236 @@ namespace l_system {
       return rules_;
     }
 
-    auto generate(int generations) const noexcept -> LString<T> {
+    //the rules compiled for lookup, built here on the first call after the rules or context options change
+    auto compiled() const -> const LRuleTable<T, Hash>& {
 
-      auto current = axiom_;
+      if(compiled_.stale.load(std::memory_order_acquire)) {
 
-      for(int i = 0; i < generations; ++i) {
+        const std::lock_guard<std::mutex> lock(compiled_.mutex);
+
+        if(compiled_.stale.load(std::memory_order_relaxed)) {
 
-        std::vector<LString<T>> result;
-        result.reserve(current.size());
+          compiled_.table.build(rules_, context_);
+          compiled_.stale.store(false, std::memory_order_release);
+        }
+      }
+
+      return compiled_.table;
+    }
 
-        for(size_t j = 0; j < current.size(); ++j) {
+    auto generate(int generations) const -> LString<T> {
 
-          LString<T> symbolReplacement = {current[j]};
+      return generate(generations, 1);
+    }
 
-          for(const auto& rule : rules_) {
+    //generates on up to threads threads, the result is identical to the single threaded generation
+    //with caching off, as by default, generating only reads the system, with it on, generate writes the cache and must not run on several threads at once
+    auto generate(int generations, unsigned threads) const -> LString<T> {
 
-              if(rule.applies(current[j])) {
+      //a negative number of generations gives the axiom, and is cached as generation 0 would be
+      generations = std::max(0, generations);
 
-                symbolReplacement = rule.produce(current[j]);
-              }
-          }
+      const auto& table = compiled();
+      const auto [start, cached] = closestCached(generations);
+
+      auto current = *cached;
+      LString<T> next;
+
+      for(int i = start; i < generations; ++i) {
+
+        advance(table, current, next, threads, i);
+        std::swap(current, next);
+      }
+
+      if(cacheLimit_ > 0) {
+
+        cache(generations, current);
+      }
+
+      return current;
+    }
+
+    //generates into result, rewriting back and forth between result and scratch so that both keep their capacity for the next call
+    //continues from a cached generation but never caches, gathers statistics or calls the generation callback,
+    //so several threads may generate from one system at once, as long as none caches meanwhile
+    void generateInto(int generations, LString<T>& result, LString<T>& scratch, unsigned threads = 1) const {
+
+      generations = std::max(0, generations);
+
+      const auto& table = compiled();
+      const auto [start, cached] = closestCached(generations);
+
+      result.assign(cached->begin(), cached->end());
+
+      for(int i = start; i < generations; ++i) {
+
+        step(table, result, scratch, threads, {seed_, static_cast<std::uint64_t>(i), 0});
+        std::swap(result, scratch);
+      }
+    }
 
-          result.emplace_back(symbolReplacement);
+    //generates with every symbol and parameter of the generations along the way taken from two arenas
+    //a generation lives in one arena while the next is rewritten into the other, which is rewound just before, so memory is freed in bulk and its blocks reused
+    //threads allocate from blocks of their own, and the last generation is rewritten straight into a string whose memory comes from resource
+    //with more than one thread the last generation's parameters are allocated from every thread, so resource must then be thread safe,
+    //as the default new and delete resource, a synchronized_pool_resource and an LArena are
+    auto generate(int generations, unsigned threads, std::pmr::memory_resource* resource) const -> pmr::LString<T> {
+
+      generations = std::max(0, generations);
+
+      const auto& table = compiled();
+      const auto [start, cached] = closestCached(generations);
+
+      if(start >= generations) {
+
+        return pmr::LString<T>(cached->begin(), cached->end(), resource);
+      }
+
+      LArena arenas[2];
+      pmr::LString<T> strings[2] = {pmr::LString<T>(cached->begin(), cached->end(), &arenas[0]), pmr::LString<T>(&arenas[1])};
+      size_t current = 0;
+
+      for(int i = start; i < generations - 1; ++i) {
+
+        const auto next = 1 - current;
+
+        strings[next] = pmr::LString<T>(&arenas[next]);
+        arenas[next].rewind();
+
+        advance(table, strings[current], strings[next], threads, i);
+        current = next;
+      }
+
+      //the other arena is not rewritten into again, so its blocks are handed back before the result is allocated
+      strings[1 - current] = pmr::LString<T>(&arenas[1 - current]);
+      arenas[1 - current].release();
+
+      pmr::LString<T> result(resource);
+
+      advance(table, strings[current], result, threads, generations - 1);
+
+      if(cacheLimit_ > 0) {
+
+        cache(generations, LString<T>(result.begin(), result.end()));
+      }
+
+      return result;
+    }
+
+    //hands generations 0 to generations to callback(generation, lstring) in order, each one rewritten from the last
+    //a negative number of generations hands over the axiom alone, as generate returns it
+    template <typename F>
+    void generateSeries(int generations, F&& callback, unsigned threads = 1) const {
+
+      const auto& table = compiled();
+
+      auto current = axiom_;
+      LString<T> next;
+
+      for(int i = 0;; ++i) {
+
+        callback(i, std::as_const(current));
+
+        if(i >= generations) {
+
+          break;
+        }
+
+        //skip ahead through cached generations rather than rewriting them again
+        if(cache_.count(i + 1) != 0) {
+
+          current = cache_.at(i + 1);
+          continue;
         }
 
-        current = LString<T>();
+        advance(table, current, next, threads, i);
+        std::swap(current, next);
 
-        for(auto& res : result) {
+        if(cacheLimit_ > 0) {
 
-          current.insert(current.end(), std::make_move_iterator(res.begin()), std::make_move_iterator(res.end()));
+          cache(i + 1, current);
         }
       }
+    }
+
+    //generates into a compact string, in which rules rewrite symbol ids through the compiled table without touching T
+    auto generateCompact(int generations) const -> LCompactString<T, Hash> {
+
+      const auto& table = compiled();
+      LCompactString<T, Hash> current(table.registry());
+      LCompactString<T, Hash> next;
+
+      for(const auto& symbol : axiom_) {
+
+        current.push_back(symbol);
+      }
+
+      for(int i = 0; i < generations; ++i) {
+
+        table.rewrite(current, next, {seed_, static_cast<std::uint64_t>(i), 0});
+        std::swap(current, next);
+      }
 
       return current;
     }
 
+    //generates without holding whole generations in memory, reading each one from chunk files and writing the next into new ones
+    //reading the next chunk and writing the last overlap rewriting, and memory is about budget bytes whatever the generations' lengths
+    //starts from the deepest cached generation, and leaves only the last generation's files in directory, which must exist
+    //rules must be context free, or nothing is generated, guards, stochastic rules and parameter expressions give the same result as generate
+    //a negative number of generations writes the axiom, as generate returns it
+    auto generateOnDisk(int generations, const std::string& directory, size_t budget, unsigned threads = 1) const -> std::optional<LDiskString<T, Hash>> {
+
+      generations = std::max(0, generations);
+
+      const auto capacity = chunkCapacity(budget);
+      const auto [start, cached] = closestCached(generations);
+
+      LChunkWriter<T, Hash> writer(directory, start);
+
+      for(size_t begin = 0; begin < cached->size(); begin += capacity) {
+
+        LString<T> chunk(cached->begin() + static_cast<std::ptrdiff_t>(begin), cached->begin() + static_cast<std::ptrdiff_t>(std::min(cached->size(), begin + capacity)));
+
+        writer.write(chunk);
+      }
+
+      auto first = writer.finish();
+
+      if(!first) {
+
+        return std::nullopt;
+      }
+
+      auto result = rewriteOnDisk(*first, generations, directory, capacity, threads);
+
+      //the written start is only deleted once rewritten into a deeper generation, never when it is the result
+      if(result && result->generation() != first->generation()) {
+
+        first->remove();
+      }
+
+      return result;
+    }
+
+    //continues from a generation already on disk, such as one found by LDiskString::open, whose files are kept
+    auto generateOnDisk(const LDiskString<T, Hash>& from, int generations, const std::string& directory, size_t budget, unsigned threads = 1) const -> std::optional<LDiskString<T, Hash>> {
+
+      return rewriteOnDisk(from, generations, directory, chunkCapacity(budget), threads);
+    }
+
+    //lazily yields the symbols of a generation in order without generating it in full
+    //only for rules which rewrite every symbol of a type alike, that is deterministic context-free rules without guards or parameter expressions, other rules give nothing
+    auto stream(int generations) const noexcept -> std::optional<LStream<T, Hash>> {
+
+      if(!compiled().uniform()) {
+
+        return std::nullopt;
+      }
+
+      return LStream<T, Hash>(compiled(), axiom_, generations);
+    }
+
     auto getAllSymbolTypes() const noexcept -> std::set<LSymbolType<T>> {
 
       std::set<LSymbolType<T>> result;
@@ -88,10 +921,13 @@ namespace l_system {
 
         result.emplace(rule.predecessor());
 
-        for(const auto& symbolType : rule.result()) {
+        for(const auto& alternative : rule.alternatives()) {
 
-          result.emplace(symbolType);
+          result.insert(alternative.result.begin(), alternative.result.end());
         }
+
+        result.insert(rule.left().begin(), rule.left().end());
+        result.insert(rule.right().begin(), rule.right().end());
       }
 
       return result;
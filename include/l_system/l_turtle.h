@@ -0,0 +1,279 @@
+#ifndef L_SYSTEM_TURTLE_H
+#define L_SYSTEM_TURTLE_H
+
+#include <cmath>
+#include <iterator>
+#include <vector>
+
+#include "l_system/l_registry.h"
+#include "l_system/l_compact.h"
+
+namespace l_system {
+
+  enum LTurtleAction : unsigned char {
+
+    LTURTLE_NONE, //the symbol is skipped
+    LTURTLE_FORWARD, //moves forward, drawing a segment
+    LTURTLE_MOVE, //moves forward without drawing
+    LTURTLE_TURN, //turns counterclockwise by an angle in degrees, clockwise if it is negative
+    LTURTLE_PUSH, //saves the turtle's state, opening a branch
+    LTURTLE_POP, //restores the last saved state, closing a branch, ignored if no branch is open
+    LTURTLE_WIDTH, //sets the width of the segments drawn next
+  };
+
+  //line segments, stored as a structure of arrays so that each coordinate is contiguous
+  struct LSegments {
+
+    std::vector<float> x0;
+    std::vector<float> y0;
+    std::vector<float> x1;
+    std::vector<float> y1;
+    std::vector<float> width;
+
+    void reserve(size_t segments) {
+
+      x0.reserve(segments);
+      y0.reserve(segments);
+      x1.reserve(segments);
+      y1.reserve(segments);
+      width.reserve(segments);
+    }
+
+    void clear() noexcept {
+
+      x0.clear();
+      y0.clear();
+      x1.clear();
+      y1.clear();
+      width.clear();
+    }
+
+    auto size() const noexcept -> size_t {
+
+      return x0.size();
+    }
+  };
+
+  //interprets strings as drawing instructions for a 2D turtle, appending the segments it draws to an LSegments
+  //each symbol type is bound to an action with a default argument, a symbol with a float parameter uses its first one instead
+  //symbols are consumed in order from any range, so a system's stream can be drawn without generating the string at all
+  //headings and widths are tracked as symbols arrive, while steps are queued and their trigonometry done a batch at a time
+  template <typename T, typename Hash = std::hash<T>>
+  class LTurtle {
+
+    struct Binding {
+
+      LTurtleAction action = LTURTLE_NONE;
+      float argument = 0.0f;
+    };
+
+    struct Position {
+
+      float x;
+      float y;
+    };
+
+    struct Bearing {
+
+      float heading;
+      float width;
+    };
+
+    constexpr const static size_t BATCH = 1024;
+    constexpr const static float RADIANS = 3.14159265358979323846f / 180.0f; //per degree
+
+    LSymbolRegistry<T, Hash> registry_;
+    std::vector<Binding> bindings_; //symbol id -> its action
+    Position position_ = {0.0f, 0.0f}; //where the turtle is once every queued step is taken
+    Bearing bearing_ = {90.0f * RADIANS, 1.0f}; //heading in radians and width, always current
+    std::vector<Position> positions_; //positions saved by pushes
+    std::vector<Bearing> bearings_; //headings and widths saved by pushes
+
+    std::vector<LTurtleAction> queue_; //the steps, pushes and pops not yet taken, in order
+    std::vector<float> headings_; //per queued step
+    std::vector<float> lengths_;
+    std::vector<float> widths_;
+    std::vector<float> dx_;
+    std::vector<float> dy_;
+
+    template <typename S>
+    static auto argument(const S& symbol, const Binding& binding) noexcept -> float {
+
+      return (parameterCount(symbol.paramSet(), LFLOAT) > 0) ? symbol.getFloatParam(0) : binding.argument;
+    }
+
+    //takes the queued steps, first turning every heading and length into a displacement, then adding them up in order
+    void flush(LSegments& out) {
+
+      const auto count = headings_.size();
+
+      dx_.resize(count);
+      dy_.resize(count);
+
+      //independent iterations, which vectorize where the compiler has vector versions of cos and sin
+      for(size_t k = 0; k < count; ++k) {
+
+        dx_[k] = lengths_[k] * std::cos(headings_[k]);
+        dy_[k] = lengths_[k] * std::sin(headings_[k]);
+      }
+
+      size_t step = 0;
+
+      for(auto action : queue_) {
+
+        if(action == LTURTLE_PUSH) {
+
+          positions_.emplace_back(position_);
+          continue;
+        }
+
+        if(action == LTURTLE_POP) {
+
+          position_ = positions_.back();
+          positions_.pop_back();
+          continue;
+        }
+
+        const Position next = {position_.x + dx_[step], position_.y + dy_[step]};
+
+        if(action == LTURTLE_FORWARD) {
+
+          out.x0.emplace_back(position_.x);
+          out.y0.emplace_back(position_.y);
+          out.x1.emplace_back(next.x);
+          out.y1.emplace_back(next.y);
+          out.width.emplace_back(widths_[step]);
+        }
+
+        position_ = next;
+        ++step;
+      }
+
+      queue_.clear();
+      headings_.clear();
+      lengths_.clear();
+      widths_.clear();
+    }
+
+    template <typename S>
+    void consume(const S& symbol, LSymbolId id, LSegments& out) {
+
+      if(id >= bindings_.size() || bindings_[id].action == LTURTLE_NONE) {
+
+        return;
+      }
+
+      const auto& binding = bindings_[id];
+
+      switch (binding.action) {
+        case LTURTLE_FORWARD:
+        case LTURTLE_MOVE:
+          headings_.emplace_back(bearing_.heading);
+          lengths_.emplace_back(argument(symbol, binding));
+          widths_.emplace_back(bearing_.width);
+          break;
+        case LTURTLE_TURN:
+          bearing_.heading += argument(symbol, binding) * RADIANS;
+          return;
+        case LTURTLE_WIDTH:
+          bearing_.width = argument(symbol, binding);
+          return;
+        case LTURTLE_PUSH:
+          bearings_.emplace_back(bearing_);
+          break;
+        case LTURTLE_POP:
+          //an unbalanced pop is never queued, so the positions saved when flushing stay balanced too
+          if(bearings_.empty()) {
+
+            return;
+          }
+
+          bearing_ = bearings_.back();
+          bearings_.pop_back();
+          break;
+        default:
+          return;
+      }
+
+      queue_.emplace_back(binding.action);
+
+      if(queue_.size() == BATCH) {
+
+        flush(out);
+      }
+    }
+
+  public:
+
+    LTurtle() {
+
+      queue_.reserve(BATCH);
+      headings_.reserve(BATCH);
+      lengths_.reserve(BATCH);
+      widths_.reserve(BATCH);
+    }
+
+    //binds a symbol type to an action, argument is a length, an angle in degrees or a width
+    void setAction(const LSymbolType<T>& type, LTurtleAction action, float argument = 0.0f) {
+
+      const auto id = registry_.intern(type);
+
+      if(id >= bindings_.size()) {
+
+        bindings_.resize(id + 1);
+      }
+
+      bindings_[id] = {action, argument};
+    }
+
+    //puts the turtle at a position, heading in degrees from the x axis, and forgets saved branches
+    void reset(float x = 0.0f, float y = 0.0f, float heading = 90.0f, float width = 1.0f) noexcept {
+
+      position_ = {x, y};
+      bearing_ = {heading * RADIANS, width};
+      positions_.clear();
+      bearings_.clear();
+    }
+
+    //draws the symbols of [first, last) in order, carrying the turtle's state over into the next call
+    template <typename It>
+    void interpret(It first, It last, LSegments& out) {
+
+      for(; first != last; ++first) {
+
+        const auto& symbol = *first;
+
+        consume(symbol, registry_.find(symbol.type().representation()), out);
+      }
+
+      flush(out);
+    }
+
+    //draws any range of symbols, such as a generated string, a system's stream or a derivation's slice
+    template <typename R>
+    void interpret(const R& range, LSegments& out) {
+
+      interpret(std::begin(range), std::end(range), out);
+    }
+
+    void interpret(const LCompactString<T, Hash>& lstring, LSegments& out) {
+
+      //ids of the string's registry are translated once, rather than looking up each symbol
+      std::vector<LSymbolId> ids(lstring.registry().size());
+
+      for(LSymbolId id = 0; id < ids.size(); ++id) {
+
+        ids[id] = registry_.find(lstring.registry().type(id).representation());
+      }
+
+      for(size_t i = 0; i < lstring.size(); ++i) {
+
+        consume(lstring[i], ids[lstring.id(i)], out);
+      }
+
+      flush(out);
+    }
+  };
+}
+
+#endif